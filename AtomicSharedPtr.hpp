@@ -0,0 +1,132 @@
+#ifndef ATOMIC_SHARED_PTR_H
+#define ATOMIC_SHARED_PTR_H
+
+#include <atomic>       // Для std::atomic
+#include <cassert>
+#include <cstdint>      // Для std::uintptr_t и std::uint64_t
+#include <utility>      // Для std::move
+
+#include "SharedPtr.hpp"
+
+// ConcurrentSharedPtr, который можно читать и заменять из разных потоков без блокировок.
+//
+// Одно 64-битное слово хранит адрес блока управления (младшие 48 бит) и число читателей,
+// которые уже взяли адрес, но еще не увеличили счетчик ссылок (старшие 16 бит, "локальный" счетчик).
+// Читатель увеличивает локальный счетчик, берет настоящую ссылку и снимает локальную.
+// Писатель, заменивший блок, переносит локальный счетчик старого блока в его счетчик ссылок,
+// поэтому блок не удаляется, пока читатели не закончили
+template<typename T>
+class AtomicSharedPtr {
+private:
+    using Pointer = SharedPtr<T, AtomicRefCount>;
+    using ControlBlock = detail::ControlBlockBase<AtomicRefCount>;
+
+    static_assert(sizeof(void*) == 8, "Адрес и локальный счетчик упаковываются в 64 бита");
+
+    static constexpr int localShift = 48;
+    static constexpr std::uint64_t oneLocal = std::uint64_t(1) << localShift;
+    static constexpr std::uint64_t pointerMask = oneLocal - 1;
+
+    mutable std::atomic<std::uint64_t> word; // load() тоже меняет локальный счетчик
+
+    static ControlBlock* blockOf(std::uint64_t value) noexcept {
+        return reinterpret_cast<ControlBlock*>(static_cast<std::uintptr_t>(value & pointerMask));
+    }
+
+    static int localOf(std::uint64_t value) noexcept {
+        return static_cast<int>(value >> localShift);
+    }
+
+    // Ссылка SharedPtr переходит в слово; указатель должен совпадать с объектом блока.
+    // В слове хранится только блок, поэтому указатели из конструктора совмещения не поддерживаются
+    static std::uint64_t take(Pointer& value) noexcept {
+        ControlBlock* block = value.ctrl;
+        assert(!block || static_cast<void*>(value.ptr) == block->managedObject());
+        assert((reinterpret_cast<std::uintptr_t>(block) & ~pointerMask) == 0);
+        value.ptr = nullptr;
+        value.ctrl = nullptr;
+        return reinterpret_cast<std::uintptr_t>(block);
+    }
+
+    static Pointer adopt(ControlBlock* block) noexcept {
+        return block ? Pointer(static_cast<T*>(block->managedObject()), block) : Pointer();
+    }
+
+    // Слово со старым блоком снято: читатели, успевшие взять адрес, получают ссылки в общем счетчике
+    static Pointer retire(std::uint64_t old) noexcept {
+        ControlBlock* block = blockOf(old);
+        if (block && localOf(old) > 0) {
+            AtomicRefCount::add(block->refCount, localOf(old));
+        }
+        return adopt(block);
+    }
+
+public:
+    AtomicSharedPtr() noexcept : word(0) {}
+
+    explicit AtomicSharedPtr(Pointer value) noexcept : word(take(value)) {}
+
+    AtomicSharedPtr(const AtomicSharedPtr&) = delete;
+    AtomicSharedPtr& operator=(const AtomicSharedPtr&) = delete;
+
+    ~AtomicSharedPtr() {
+        retire(word.load(std::memory_order_acquire));
+    }
+
+    bool isLockFree() const noexcept {
+        return word.is_lock_free();
+    }
+
+    Pointer load() const noexcept {
+        // Локальная ссылка не дает писателю освободить блок, пока берется настоящая
+        std::uint64_t current = word.fetch_add(oneLocal, std::memory_order_acquire) + oneLocal;
+        ControlBlock* block = blockOf(current);
+        if (block) {
+            AtomicRefCount::increment(block->refCount);
+        }
+
+        // Снять свою локальную ссылку; если блок уже заменили, ее перенесли в общий счетчик
+        while (true) {
+            if (blockOf(current) != block || localOf(current) == 0) {
+                if (block) {
+                    block->releaseStrong(); // Лишняя ссылка, объект держит наша собственная
+                }
+                break;
+            }
+            if (word.compare_exchange_weak(current, current - oneLocal, std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        return adopt(block);
+    }
+
+    void store(Pointer value) noexcept {
+        exchange(std::move(value));
+    }
+
+    Pointer exchange(Pointer value) noexcept {
+        return retire(word.exchange(take(value), std::memory_order_acq_rel));
+    }
+
+    // Замена на desired, если в слове лежит тот же объект, что в expected.
+    // Иначе expected получает текущее значение и возвращается false
+    bool compareExchange(Pointer& expected, Pointer desired) noexcept {
+        const std::uint64_t replacement = take(desired);
+        std::uint64_t current = word.load(std::memory_order_relaxed);
+        while (blockOf(current) == expected.ctrl) {
+            // Сравнение по блоку безопасно: expected держит ссылку, блок не может освободиться
+            // и появиться по тому же адресу (проблема ABA)
+            if (word.compare_exchange_weak(current, replacement, std::memory_order_acq_rel,
+                                           std::memory_order_relaxed)) {
+                retire(current); // Ссылка слова на старый блок снимается
+                return true;
+            }
+        }
+        retire(replacement); // desired не понадобился
+        expected = load();
+        return false;
+    }
+};
+
+#endif
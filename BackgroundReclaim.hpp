@@ -0,0 +1,264 @@
+#pragma once
+
+#ifndef BACKGROUND_RECLAIM_H
+#define BACKGROUND_RECLAIM_H
+
+#include <atomic>
+#include <chrono>    // Для std::chrono::milliseconds
+#include <condition_variable>
+#include <cstddef>   // Для std::size_t
+#include <mutex>
+#include <new>       // Для std::nothrow
+#include <thread>
+#include <type_traits>
+#include <utility>   // Для std::move и std::forward
+#include <vector>
+
+#include "SharedPtr.hpp"
+
+#ifdef __linux__
+#include <pthread.h> // pthread_setschedparam, SCHED_IDLE
+#endif
+
+// Освобождение в фоновом потоке: объект, последний владелец которого уходит, ставится
+// в очередь, а рабочий поток удаляет очередь пачками. Вызывающий поток платит только
+// за постановку в очередь, даже если объект - список из миллионов узлов.
+// Очередь ограничена по памяти: объекты, которые не помещаются в maxPendingBytes,
+// удаляются сразу в вызывающем потоке, как без фонового потока.
+// Размер объекта в байтах задает вызывающий (для списка - оценка памяти всех узлов).
+// Ставить объекты в очередь можно из любых потоков, в том числе из деструкторов удаляемых объектов.
+// Постановка в очередь не берет блокировок: очередь - стек на атомарном указателе,
+// рабочий поток забирает его целиком одним обменом. Мьютекс нужен только для сна
+// рабочего потока и для ожидания в flush, поэтому рабочий поток с низким приоритетом,
+// вытесненный в любой момент, не задерживает вызывающих
+class BackgroundReclaimer {
+private:
+    using DestroyFunction = void (*)(void*) noexcept;
+
+    struct Retired {
+        void* object;
+        DestroyFunction destroy;
+        std::size_t bytes;
+        Retired* next;
+    };
+
+    // Вызывающие будят рабочий поток без мьютекса, и уведомление может прийти, пока он
+    // засыпает; тогда он проснется сам через столько времени (очередь при этом ограничена)
+    static constexpr std::chrono::milliseconds wakeInterval{20};
+
+    std::atomic<Retired*> head{nullptr};
+    std::atomic<std::size_t> pending{0};   // Байты в очереди и в обрабатываемой пачке
+    std::atomic<std::size_t> retired{0};   // Поставлено в очередь за все время
+    std::atomic<std::size_t> destroyed{0}; // Удалено рабочим потоком
+    std::atomic<std::size_t> inlined{0};
+    std::atomic<int> flushWaiters{0};
+    std::atomic<bool> stopping{false};
+    const std::size_t limit;
+
+    std::mutex mutex;
+    std::condition_variable wake;    // Рабочему потоку: очередь не пуста или пора завершаться
+    std::condition_variable drained; // Потокам в flush: пачка удалена
+    std::thread worker;              // Последним: поток стартует после остальных полей
+
+    template <typename T>
+    static void deleteObject(void* p) noexcept {
+        delete static_cast<T*>(p);
+    }
+
+    // Пачка из стека идет в обратном порядке: разворачиваем, чтобы удалять в порядке постановки
+    static Retired* reversed(Retired* list) noexcept {
+        Retired* result = nullptr;
+        while (list) {
+            Retired* next = list->next;
+            list->next = result;
+            result = list;
+            list = next;
+        }
+        return result;
+    }
+
+    void run() {
+#ifdef __linux__
+        // Рабочий поток уступает процессор остальным: разбуженный, он не вытесняет
+        // вызывающий поток на том же ядре. Если процессор занят постоянно, очередь
+        // доходит до ограничения и объекты удаляются вызывающими потоками
+        sched_param param{};
+        pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+#endif
+        while (true) {
+            Retired* batch = head.exchange(nullptr, std::memory_order_acquire);
+            if (!batch) {
+                if (stopping.load(std::memory_order_acquire)) {
+                    break; // Остановка, и все поставленное уже удалено
+                }
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait_for(lock, wakeInterval, [this] {
+                    return head.load(std::memory_order_relaxed) != nullptr ||
+                           stopping.load(std::memory_order_relaxed);
+                });
+                continue;
+            }
+
+            std::size_t bytes = 0;
+            std::size_t count = 0;
+            for (Retired* current = reversed(batch); current != nullptr; ++count) {
+                Retired* next = current->next;
+                current->destroy(current->object);
+                bytes += current->bytes;
+                delete current;
+                current = next;
+            }
+            pending.fetch_sub(bytes, std::memory_order_relaxed);
+            // seq_cst в паре с flush: либо flush увидит новый счетчик, либо здесь виден ожидающий
+            destroyed.fetch_add(count);
+            if (flushWaiters.load() > 0) {
+                std::lock_guard<std::mutex> lock(mutex);
+                drained.notify_all();
+            }
+        }
+    }
+
+    // Место в ограничении очереди: pending растет, только если не выходит за limit
+    bool reserve(std::size_t bytes) noexcept {
+        std::size_t current = pending.load(std::memory_order_relaxed);
+        do {
+            if (bytes > limit - current) {
+                return false;
+            }
+        } while (!pending.compare_exchange_weak(current, current + bytes, std::memory_order_relaxed));
+        return true;
+    }
+
+    void enqueue(void* object, DestroyFunction destroy, std::size_t bytes) noexcept {
+        Retired* node = nullptr;
+        if (!stopping.load(std::memory_order_relaxed) && reserve(bytes)) {
+            node = new (std::nothrow) Retired{object, destroy, bytes, nullptr};
+            if (!node) {
+                pending.fetch_sub(bytes, std::memory_order_relaxed); // Нет памяти под очередь
+            }
+        }
+        if (!node) {
+            inlined.fetch_add(1, std::memory_order_relaxed);
+            destroy(object);
+            return;
+        }
+
+        retired.fetch_add(1, std::memory_order_relaxed);
+        Retired* expected = head.load(std::memory_order_relaxed);
+        do {
+            node->next = expected;
+        } while (!head.compare_exchange_weak(expected, node, std::memory_order_release, std::memory_order_relaxed));
+        if (!expected) {
+            wake.notify_one(); // Рабочий поток спит только при пустой очереди
+        }
+    }
+
+public:
+    static constexpr std::size_t defaultPendingBytes = std::size_t(64) << 20;
+
+    explicit BackgroundReclaimer(std::size_t maxPendingBytes = defaultPendingBytes)
+        : limit(maxPendingBytes), worker([this] { run(); }) {}
+
+    BackgroundReclaimer(const BackgroundReclaimer&) = delete;
+    BackgroundReclaimer& operator=(const BackgroundReclaimer&) = delete;
+
+    // Все поставленные объекты удаляются до завершения рабочего потока
+    ~BackgroundReclaimer() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping.store(true, std::memory_order_release);
+        }
+        wake.notify_one();
+        worker.join();
+    }
+
+    // Общий фоновый поток программы; запускается при первом обращении
+    static BackgroundReclaimer& global() {
+        static BackgroundReclaimer reclaimer;
+        return reclaimer;
+    }
+
+    // Удалить object (созданный через new) в фоновом потоке
+    template <typename T>
+    void retire(T* object, std::size_t bytes = sizeof(T)) noexcept {
+        if (object) {
+            enqueue(object, &deleteObject<T>, bytes);
+        }
+    }
+
+    // Отпустить SharedPtr: ссылка переносится в очередь и отпускается фоновым потоком,
+    // поэтому объект, если ссылка окажется последней, удаляется там же. Проверять useCount
+    // заранее нельзя: при AtomicRefCount два потока могут оба увидеть 2 и оба отпустить ссылку
+    // сами, и последний удалит объект у себя.
+    // Узлы, связанные SharedPtr, лучше отдавать целым списком (retireOwner): цепочка,
+    // удаляемая деструкторами узлов, рекурсивна
+    template <typename T, typename RefCount>
+    void retire(SharedPtr<T, RefCount>&& ptr, std::size_t bytes = sizeof(T)) noexcept {
+        retireOwner(std::move(ptr), bytes);
+    }
+
+    // Перенести владельца (список, UniquePtr, контейнер) в очередь и разрушить его в фоновом потоке.
+    // Переносом владелец остается пустым и дешево разрушается у вызывающего
+    template <typename Owner>
+    void retireOwner(Owner&& owner, std::size_t bytes) noexcept {
+        using Stored = std::decay_t<Owner>;
+        static_assert(std::is_move_constructible<Stored>::value, "Владелец переносится в очередь перемещением");
+        Stored* box = nullptr;
+        try {
+            box = new Stored(std::move(owner));
+        } catch (...) {
+            Stored dying(std::move(owner)); // Нет памяти под перенос: разрушаем сразу
+            return;
+        }
+        enqueue(box, &deleteObject<Stored>, bytes);
+    }
+
+    // Дождаться, пока очередь опустеет, включая объекты, поставленные из удаляемых.
+    // Нельзя вызывать из удаляемых объектов
+    void flush() {
+        flushWaiters.fetch_add(1);
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            drained.wait(lock, [this] { return destroyed.load() == retired.load(); });
+        }
+        flushWaiters.fetch_sub(1);
+    }
+
+    std::size_t pendingBytes() const {
+        return pending.load(std::memory_order_relaxed);
+    }
+
+    std::size_t maxPendingBytes() const {
+        return limit;
+    }
+
+    // Сколько объектов ушло в фоновый поток и сколько удалено сразу из-за ограничения памяти
+    std::size_t deferredCount() const {
+        return retired.load(std::memory_order_relaxed);
+    }
+
+    std::size_t inlineCount() const {
+        return inlined.load(std::memory_order_relaxed);
+    }
+};
+
+// Удалитель для UniquePtr: объект удаляется фоновым потоком.
+// Без явного BackgroundReclaimer используется BackgroundReclaimer::global()
+template <typename T>
+class DeferredDelete {
+private:
+    BackgroundReclaimer* reclaimer;
+    std::size_t bytes;
+
+public:
+    DeferredDelete() noexcept : reclaimer(nullptr), bytes(sizeof(T)) {}
+
+    explicit DeferredDelete(BackgroundReclaimer& r, std::size_t objectBytes = sizeof(T)) noexcept
+        : reclaimer(&r), bytes(objectBytes) {}
+
+    void operator()(T* p) const noexcept {
+        (reclaimer ? *reclaimer : BackgroundReclaimer::global()).retire(p, bytes);
+    }
+};
+
+#endif
@@ -0,0 +1,84 @@
+#pragma once
+
+#ifndef COW_PTR_H
+#define COW_PTR_H
+
+#include <atomic>      // Для std::atomic_thread_fence
+#include <cassert>
+#include <type_traits>
+#include <utility>     // Для std::forward и std::move
+
+#include "SharedPtr.hpp"
+
+// Копирование при записи поверх SharedPtr: копии CowPtr делят один объект,
+// чтение его не копирует. write() отдает изменяемую ссылку; если объект видит кто-то еще
+// (другие владельцы или WeakPtr), сначала создается своя копия, иначе объект меняется на месте.
+// Ссылку от write() нельзя использовать после копирования этого CowPtr: копия делит объект,
+// и запись через старую ссылку изменила бы и ее. Для новой записи нужно снова вызвать write().
+// Один CowPtr не меняют из нескольких потоков; разные копии - можно при AtomicRefCount
+template <typename T, typename RefCount = NonAtomicRefCount>
+class CowPtr {
+private:
+    SharedPtr<T, RefCount> data;
+
+public:
+    CowPtr() = default;
+
+    // Объект SharedPtr становится общим с CowPtr: пока есть другие ссылки, он не меняется
+    explicit CowPtr(SharedPtr<T, RefCount> shared) noexcept : data(std::move(shared)) {}
+
+    const T& read() const {
+        return *data;
+    }
+
+    const T& operator*() const {
+        return *data;
+    }
+
+    const T* operator->() const {
+        return data.get();
+    }
+
+    // Изменяемый объект; копируется, если его делят другие владельцы или на него есть WeakPtr
+    // (lock() увидел бы изменения). Без слабых ссылок и с одним владельцем новых ссылок
+    // взять неоткуда, поэтому изменение на месте безопасно.
+    // CowPtr не должен быть пустым. Если копирование бросает исключение, CowPtr не меняется
+    T& write() {
+        assert(data && "write() у пустого CowPtr");
+        if (data.useCount() > 1 || data.weakCount() > 0) {
+            data = makeShared<T, RefCount>(*data);
+        } else if (std::is_same<RefCount, AtomicRefCount>::value) {
+            // Записи потоков, отпустивших объект, видны до изменения на месте
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        return *data.get();
+    }
+
+    bool unique() const {
+        return data.useCount() == 1;
+    }
+
+    int useCount() const {
+        return data.useCount();
+    }
+
+    explicit operator bool() const {
+        return static_cast<bool>(data);
+    }
+
+    const SharedPtr<T, RefCount>& shared() const {
+        return data;
+    }
+
+    // Вернуть объект как SharedPtr; CowPtr остается пустым
+    SharedPtr<T, RefCount> takeShared() noexcept {
+        return std::move(data);
+    }
+};
+
+template <typename T, typename RefCount = NonAtomicRefCount, typename... Args>
+CowPtr<T, RefCount> makeCow(Args&&... args) {
+    return CowPtr<T, RefCount>(makeShared<T, RefCount>(std::forward<Args>(args)...));
+}
+
+#endif
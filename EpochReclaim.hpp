@@ -0,0 +1,194 @@
+#pragma once
+
+#ifndef EPOCH_RECLAIM_H
+#define EPOCH_RECLAIM_H
+
+#include <atomic>   // Для std::atomic
+#include <cstddef>  // Для std::size_t
+#include <cstdint>  // Для std::uint64_t
+#include <deque>
+#include <stdexcept> // Для std::runtime_error
+#include <utility>  // Для std::move
+
+namespace SmartPointer {
+
+    // Политики освобождения узлов списка:
+    // ImmediateReclaim - узел удаляется сразу (по умолчанию, читатели только в потоке писателя);
+    // EpochReclaim - узел удаляется, когда ни один читатель уже не может его видеть
+    struct ImmediateReclaim {};
+    struct EpochReclaim {};
+
+    // Освобождение по эпохам. Читатель на время обхода объявляет текущую глобальную эпоху.
+    // Эпоха продвигается, только если все активные читатели объявили текущую,
+    // поэтому объект, снятый в эпоху e, уже никто не видит после перехода глобальной эпохи в e + 2
+    class EpochDomain {
+    public:
+        // Сколько потоков одновременно могут обходить структуры
+        static constexpr std::size_t maxThreads = 128;
+
+    private:
+        // Состояние потока: 0 - вне обхода, иначе (эпоха << 1) | 1
+        struct alignas(64) Record {
+            std::atomic<std::uint64_t> state{0};
+            std::atomic<bool> inUse{false};
+        };
+
+        // Ячейка закрепляется за потоком при первом обходе и освобождается при его завершении.
+        // Если ячейки не нашлось, поток попробует снова при следующем обходе
+        struct ThreadSlot {
+            Record* record;
+            int depth = 0; // Вложенные обходы объявляют эпоху один раз
+
+            explicit ThreadSlot(EpochDomain& domain) : record(domain.claim()) {}
+
+            ~ThreadSlot() {
+                record->state.store(0, std::memory_order_release);
+                record->inUse.store(false, std::memory_order_release);
+            }
+        };
+
+        std::atomic<std::uint64_t> epoch{0};
+        Record records[maxThreads];
+
+        EpochDomain() = default;
+
+        // Ячейки закреплены за потоками до их завершения, поэтому ожидание свободной ячейки
+        // могло бы не кончиться никогда: при переполнении бросается исключение
+        Record* claim() {
+            for (auto& record : records) {
+                bool expected = false;
+                if (!record.inUse.load(std::memory_order_relaxed) &&
+                    record.inUse.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                    return &record;
+                }
+            }
+            throw std::runtime_error("EpochDomain: читателей больше, чем maxThreads потоков одновременно");
+        }
+
+        ThreadSlot& slot() {
+            thread_local ThreadSlot threadSlot(*this);
+            return threadSlot;
+        }
+
+    public:
+        EpochDomain(const EpochDomain&) = delete;
+        EpochDomain& operator=(const EpochDomain&) = delete;
+
+        static EpochDomain& global() {
+            static EpochDomain domain;
+            return domain;
+        }
+
+        // Объявление эпохи и чтение указателей читателем должны быть упорядочены
+        // с публикацией писателя, поэтому здесь и в списках используется seq_cst
+        void enter() {
+            ThreadSlot& threadSlot = slot();
+            if (threadSlot.depth++ == 0) {
+                const std::uint64_t current = epoch.load(std::memory_order_seq_cst);
+                threadSlot.record->state.store((current << 1) | 1, std::memory_order_seq_cst);
+            }
+        }
+
+        void leave() {
+            ThreadSlot& threadSlot = slot();
+            if (--threadSlot.depth == 0) {
+                threadSlot.record->state.store(0, std::memory_order_release);
+            }
+        }
+
+        std::uint64_t currentEpoch() const {
+            return epoch.load(std::memory_order_seq_cst);
+        }
+
+        // Переход в следующую эпоху, если все активные читатели уже в текущей
+        bool tryAdvance() {
+            std::uint64_t current = epoch.load(std::memory_order_seq_cst);
+            for (const auto& record : records) {
+                const std::uint64_t state = record.state.load(std::memory_order_seq_cst);
+                if ((state & 1) && (state >> 1) != current) {
+                    return false;
+                }
+            }
+            return epoch.compare_exchange_strong(current, current + 1, std::memory_order_seq_cst);
+        }
+
+        // Объект, снятый в эпоху retiredAt, больше недоступен читателям
+        bool isSafe(std::uint64_t retiredAt) const {
+            return currentEpoch() >= retiredAt + 2;
+        }
+    };
+
+    // Обход структуры без блокировок: пока объект жив, снятые узлы не освобождаются
+    class EpochGuard {
+    public:
+        EpochGuard() {
+            EpochDomain::global().enter();
+        }
+
+        ~EpochGuard() {
+            EpochDomain::global().leave();
+        }
+
+        EpochGuard(const EpochGuard&) = delete;
+        EpochGuard& operator=(const EpochGuard&) = delete;
+    };
+
+    // Узлы, снятые писателем и ожидающие освобождения. Принадлежит одному писателю,
+    // Deleter вызывается для узла, когда его уже не видит ни один читатель
+    template <typename T, typename Deleter>
+    class RetiredList {
+    private:
+        static constexpr std::size_t collectEvery = 64;
+
+        std::deque<std::pair<T*, std::uint64_t>> items; // Упорядочены по эпохе
+        Deleter deleter;
+        std::size_t sinceCollect = 0;
+
+    public:
+        explicit RetiredList(Deleter d = Deleter()) : deleter(std::move(d)) {}
+
+        RetiredList(const RetiredList&) = delete;
+        RetiredList& operator=(const RetiredList&) = delete;
+
+        ~RetiredList() {
+            drain();
+        }
+
+        // Вызывается после того, как узел перестал быть доступен из структуры
+        void retire(T* item) {
+            items.emplace_back(item, EpochDomain::global().currentEpoch());
+            if (++sinceCollect >= collectEvery) {
+                collect();
+            }
+        }
+
+        // Освобождение узлов, которые уже никто не видит
+        void collect() {
+            sinceCollect = 0;
+            EpochDomain& domain = EpochDomain::global();
+            domain.tryAdvance();
+            while (!items.empty() && domain.isSafe(items.front().second)) {
+                deleter(items.front().first);
+                items.pop_front();
+            }
+        }
+
+        // Освобождение всего без проверки эпох: читателей у структуры быть не должно
+        void drain() {
+            for (auto& item : items) {
+                deleter(item.first);
+            }
+            items.clear();
+        }
+
+        std::size_t size() const {
+            return items.size();
+        }
+
+        Deleter& getDeleter() {
+            return deleter;
+        }
+    };
+}
+
+#endif
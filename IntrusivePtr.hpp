@@ -0,0 +1,144 @@
+#ifndef INTRUSIVE_PTR_H
+#define INTRUSIVE_PTR_H
+
+#include <type_traits>  // Для std::enable_if и std::is_convertible
+#include <utility>      // Для std::forward
+
+#include "RefCount.hpp"
+
+// Базовый класс для объектов, которые сами хранят свой счетчик ссылок.
+// RefCount - NonAtomicRefCount (по умолчанию) или AtomicRefCount
+template<typename RefCount = NonAtomicRefCount>
+class RefCounted {
+private:
+    mutable typename RefCount::Counter refCount{0};
+
+    template <typename T>
+    friend class IntrusivePtr;
+
+    void addRef() const noexcept {
+        RefCount::increment(refCount);
+    }
+
+    // true - снята последняя ссылка
+    bool releaseRef() const noexcept {
+        return RefCount::decrement(refCount);
+    }
+
+protected:
+    RefCounted() = default;
+
+    // Копия объекта - новый объект, ссылки на оригинал к ней не относятся
+    RefCounted(const RefCounted&) : refCount(0) {}
+
+    RefCounted& operator=(const RefCounted&) {
+        return *this;
+    }
+
+    ~RefCounted() = default;
+
+public:
+    int useCount() const noexcept {
+        return RefCount::load(refCount);
+    }
+};
+
+// Указатель на объект со встроенным счетчиком: одно слово, без отдельного блока управления
+template<typename T>
+class IntrusivePtr {
+private:
+    T* ptr;
+
+    void release() {
+        if (ptr && ptr->releaseRef()) {
+            delete ptr;
+        }
+    }
+
+public:
+    template <typename U>
+    friend class IntrusivePtr;
+
+    IntrusivePtr() : ptr(nullptr) {}
+
+    // Счетчик лежит в объекте, поэтому из любого T* можно снова получить владеющий указатель
+    explicit IntrusivePtr(T* p) : ptr(p) {
+        if (ptr) ptr->addRef();
+    }
+
+    // Конструктор копирования
+    IntrusivePtr(const IntrusivePtr& other) : ptr(other.ptr) {
+        if (ptr) ptr->addRef();
+    }
+
+    // Конструктор копирования для наследуемых классов
+    template <typename U, typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+    IntrusivePtr(const IntrusivePtr<U>& other) : ptr(other.ptr) {
+        if (ptr) ptr->addRef();
+    }
+
+    // Конструктор перемещения
+    IntrusivePtr(IntrusivePtr&& other) noexcept : ptr(other.ptr) {
+        other.ptr = nullptr;
+    }
+
+    // Оператор присваивания
+    IntrusivePtr& operator=(const IntrusivePtr& other) {
+        T* newPtr = other.ptr; // other может жить внутри освобождаемого объекта
+        if (newPtr) newPtr->addRef();
+        release();
+        ptr = newPtr;
+        return *this;
+    }
+
+    // Оператор присваивания перемещением
+    IntrusivePtr& operator=(IntrusivePtr&& other) noexcept {
+        if (this != &other) {
+            T* newPtr = other.ptr;
+            other.ptr = nullptr;
+            release();
+            ptr = newPtr;
+        }
+        return *this;
+    }
+
+    // Получить количество ссылок
+    int useCount() const {
+        return ptr ? ptr->useCount() : 0;
+    }
+
+    T* get() const {
+        return ptr;
+    }
+
+    const T& operator*() const {
+        return *ptr;
+    }
+
+    const T* operator->() const {
+        return ptr;
+    }
+
+    // Сбросить указатель
+    void reset(T* newPtr = nullptr) {
+        if (newPtr) newPtr->addRef();
+        release();
+        ptr = newPtr;
+    }
+
+    // Приведение к bool для проверки наличия объекта
+    explicit operator bool() const {
+        return ptr != nullptr;
+    }
+
+    ~IntrusivePtr() {
+        release();
+    }
+};
+
+template <typename T, typename... Args>
+IntrusivePtr<T> makeIntrusive(Args&&... args) {
+    return IntrusivePtr<T>(new T(std::forward<Args>(args)...));
+}
+
+#endif
@@ -0,0 +1,176 @@
+#pragma once
+
+#ifndef LINKED_LIST_OFFSET_H
+#define LINKED_LIST_OFFSET_H
+
+#include "OffsetPtr.hpp"
+#include "SharedSegment.hpp"
+#include <cassert>
+#include <cstddef> // Для std::size_t
+#include <iostream>
+#include <iterator> // Для std::forward_iterator_tag
+#include <type_traits>
+#include <utility> // Для std::forward
+
+namespace SmartPointer {
+
+    // Односвязный список, целиком лежащий в блоке OffsetHeap: узлы и сам объект списка
+    // связаны OffsetPtr. Список, записанный в файл сегмента одним процессом, другой процесс
+    // обходит по своему адресу отображения без исправления указателей и копирования.
+    // Создается в куче блока: heap.construct<LinkedListOffset<T>>(heap).
+    // T не должен хранить обычные указатели (числа, массивы, структуры из них, OffsetPtr).
+    // Изменяет список один поток; читать его можно, пока писатель ничего не меняет
+    template <typename T>
+    class LinkedListOffset {
+    private:
+        struct Node {
+            T data;
+            OffsetPtr<Node> next;
+
+            template <typename... Args>
+            explicit Node(Node* next, Args&&... args) : data(std::forward<Args>(args)...), next(next) {}
+        };
+
+        OffsetPtr<OffsetHeap> heap;
+        OffsetPtr<Node> head;
+        std::size_t length = 0;
+
+        template <bool Const>
+        class Iterator {
+        private:
+            using NodeType = std::conditional_t<Const, const Node, Node>;
+
+            NodeType* node;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<Const, const T*, T*>;
+            using reference = std::conditional_t<Const, const T&, T&>;
+
+            Iterator() : node(nullptr) {}
+            explicit Iterator(NodeType* n) : node(n) {}
+
+            reference operator*() const {
+                return node->data;
+            }
+
+            pointer operator->() const {
+                return &node->data;
+            }
+
+            Iterator& operator++() {
+                node = node->next.get();
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                Iterator old = *this;
+                node = node->next.get();
+                return old;
+            }
+
+            friend bool operator==(const Iterator& a, const Iterator& b) {
+                return a.node == b.node;
+            }
+
+            friend bool operator!=(const Iterator& a, const Iterator& b) {
+                return a.node != b.node;
+            }
+        };
+
+    public:
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        explicit LinkedListOffset(OffsetHeap& h) : heap(&h) {
+            assert(h.contains(this) && "Список должен лежать в том же блоке, что и его узлы");
+        }
+
+        // Смещения считаются от адреса объекта, поэтому список не копируется и не перемещается
+        LinkedListOffset(const LinkedListOffset&) = delete;
+        LinkedListOffset& operator=(const LinkedListOffset&) = delete;
+
+        ~LinkedListOffset() {
+            clear();
+        }
+
+        iterator begin() {
+            return iterator(head.get());
+        }
+
+        iterator end() {
+            return iterator();
+        }
+
+        const_iterator begin() const {
+            return const_iterator(head.get());
+        }
+
+        const_iterator end() const {
+            return const_iterator();
+        }
+
+        std::size_t size() const {
+            return length;
+        }
+
+        bool empty() const {
+            return !head;
+        }
+
+        void pushFront(const T& value) {
+            emplaceFront(value);
+        }
+
+        // Узел берется из кучи блока; при нехватке места - std::bad_alloc
+        template <typename... Args>
+        T& emplaceFront(Args&&... args) {
+            Node* node = heap->template construct<Node>(head.get(), std::forward<Args>(args)...);
+            head = node;
+            ++length;
+            return node->data;
+        }
+
+        void popFront() {
+            if (Node* old = head.get()) {
+                head = old->next;
+                heap->destroy(old);
+                --length;
+            }
+        }
+
+        void clear() {
+            while (head) {
+                popFront();
+            }
+        }
+
+        bool find(const T& value) const {
+            for (const Node* current = head.get(); current != nullptr; current = current->next.get()) {
+                if (current->data == value) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        std::size_t count(const T& value) const {
+            std::size_t result = 0;
+            for (const Node* current = head.get(); current != nullptr; current = current->next.get()) {
+                result += current->data == value;
+            }
+            return result;
+        }
+
+        void print() const {
+            for (const Node* current = head.get(); current != nullptr; current = current->next.get()) {
+                std::cout << current->data << " -> ";
+            }
+            std::cout << "nullptr" << std::endl;
+        }
+    };
+}
+
+#endif
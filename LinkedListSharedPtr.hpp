@@ -4,28 +4,346 @@
 #define LINKED_LIST_SHARED_PTR_H
 
 #include "SharedPtr.hpp" 
+#include "ParallelJobs.hpp"
+#include <cassert>
+#include <cstddef> // Для std::size_t
 #include <iostream>
+#include <iterator> // Для std::forward_iterator_tag
+#include <memory> // Для std::allocator
+#include <type_traits>
+#include <utility> // Для std::move и std::forward
+#include <vector>
 
 namespace SmartPointer {
 
-    template <typename T>
+    // Alloc - аллокатор узлов (std::allocator, PoolAllocator или ArenaAllocator из NodePool.hpp).
+    // Узел и его счетчик ссылок выделяются одним блоком через allocateShared
+    template <typename T, typename Alloc = std::allocator<T>>
     class LinkedListShared {
     private:
         struct Node {
             T data;
             SharedPtr<Node> next;
-            Node(T value) : data(value), next(nullptr) {}
+            // Значение создается прямо в узле из аргументов emplaceFront/pushFront
+            template <typename... Args>
+            explicit Node(const SharedPtr<Node>& next, Args&&... args)
+                : data(std::forward<Args>(args)...), next(next) {}
         };
 
+        Alloc alloc;
         SharedPtr<Node> head;
 
+        // Узел можно перевязать, только если на него ссылается один указатель:
+        // иначе его видит копия списка, и перевязка изменила бы и ее
+        static bool exclusive(const SharedPtr<Node>& node) {
+            return node.useCount() == 1;
+        }
+
+        // Для проверок в отладочной сборке: node - узел этого списка. O(n)
+        bool ownsNode(const Node* node) const {
+            for (const Node* current = head.get(); current != nullptr; current = current->next.get()) {
+                if (current == node) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Узел target, который можно перевязать. Узлы от начала списка до target, которые видит
+        // копия списка, заменяются копиями; остаток цепочки по-прежнему общий.
+        // target - узел этого списка. При исключении список не меняется по содержимому
+        Node* privateNode(const Node* target) {
+            SharedPtr<Node>* link = &head;
+            while (true) {
+                const bool found = link->get() == target;
+                if (!exclusive(*link)) {
+                    *link = allocateShared<Node>(alloc, (*link)->next, (*link)->data);
+                }
+                if (found) {
+                    return link->get();
+                }
+                link = &link->get()->next;
+            }
+        }
+
+        // Первый узел other, отцепленный от other: перевязывается, если его не видит копия other,
+        // иначе значение копируется в новый узел. При исключении other не меняется
+        SharedPtr<Node> takeFirst(LinkedListShared& other) {
+            if (exclusive(other.head)) {
+                SharedPtr<Node> node = std::move(other.head);
+                other.head = std::move(node.get()->next);
+                return node;
+            }
+            SharedPtr<Node> node = allocateShared<Node>(alloc, SharedPtr<Node>(), other.head->data);
+            other.head = other.head->next;
+            return node;
+        }
+
+        // Все узлы other, other становится пустым. Цепочка перевязывается, если ни один ее узел
+        // не виден копиям other, иначе копируется. tail - последний узел результата
+        SharedPtr<Node> takeChain(LinkedListShared& other, Node*& tail) {
+            bool relink = true;
+            for (const SharedPtr<Node>* link = &other.head; *link; link = &(*link)->next) {
+                relink = relink && exclusive(*link);
+                tail = link->get();
+            }
+            if (relink) {
+                return std::move(other.head);
+            }
+            SharedPtr<Node> copy = buildChain(other.cbegin(), other.cend(), tail);
+            other.clear();
+            return copy;
+        }
+
+        // Освобождение цепочки, которую еще никто не видит, циклом
+        static void destroyChain(SharedPtr<Node>& chain) {
+            while (chain) {
+                chain = chain->next;
+            }
+        }
+
+        // Цепочка из [first, last) в том же порядке; tail - ее последний узел
+        template <typename It>
+        SharedPtr<Node> buildChain(It first, It last, Node*& tail) const {
+            SharedPtr<Node> chain;
+            SharedPtr<Node>* link = &chain;
+            tail = nullptr;
+            try {
+                for (; first != last; ++first) {
+                    *link = allocateShared<Node>(alloc, SharedPtr<Node>(), *first);
+                    tail = link->get();
+                    link = &tail->next;
+                }
+            } catch (...) {
+                destroyChain(chain);
+                throw;
+            }
+            return chain;
+        }
+
     public:
-        LinkedListShared() : head(nullptr) {}
+        // Прямой итератор только для чтения: узлы могут быть общими с копиями списка
+        class const_iterator {
+        private:
+            const Node* node;
+
+            friend class LinkedListShared;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = const T&;
+
+            const_iterator() : node(nullptr) {}
+            explicit const_iterator(const Node* n) : node(n) {}
+
+            reference operator*() const {
+                return node->data;
+            }
+
+            pointer operator->() const {
+                return &node->data;
+            }
+
+            const_iterator& operator++() {
+                node = node->next.get();
+                return *this;
+            }
+
+            const_iterator operator++(int) {
+                const_iterator old = *this;
+                node = node->next.get();
+                return old;
+            }
+
+            friend bool operator==(const const_iterator& a, const const_iterator& b) {
+                return a.node == b.node;
+            }
+
+            friend bool operator!=(const const_iterator& a, const const_iterator& b) {
+                return a.node != b.node;
+            }
+        };
+
+        using iterator = const_iterator;
+
+        const_iterator begin() const {
+            return const_iterator(head.get());
+        }
+
+        const_iterator end() const {
+            return const_iterator();
+        }
+
+        const_iterator cbegin() const {
+            return begin();
+        }
+
+        const_iterator cend() const {
+            return end();
+        }
+
+        LinkedListShared() : alloc(), head(nullptr) {}
+
+        explicit LinkedListShared(const Alloc& allocator) : alloc(allocator), head(nullptr) {}
+
+        // Список из [first, last) в том же порядке (см. assign)
+        template <typename It, typename = std::enable_if_t<!std::is_integral<It>::value>>
+        LinkedListShared(It first, It last, const Alloc& allocator = Alloc())
+            : LinkedListShared(allocator) {
+            assign(first, last);
+        }
+
+        template <typename Range>
+        static LinkedListShared fromRange(const Range& range, const Alloc& allocator = Alloc()) {
+            return LinkedListShared(std::begin(range), std::end(range), allocator);
+        }
+
+        LinkedListShared(const LinkedListShared& other) = default;
+        LinkedListShared(LinkedListShared&& other) = default;
+
+        LinkedListShared& operator=(const LinkedListShared& other) {
+            if (this != &other) {
+                SharedPtr<Node> newHead = other.head;
+                clear();
+                alloc = other.alloc;
+                head = std::move(newHead);
+            }
+            return *this;
+        }
+
+        LinkedListShared& operator=(LinkedListShared&& other) {
+            if (this != &other) {
+                clear();
+                alloc = std::move(other.alloc);
+                head = std::move(other.head);
+            }
+            return *this;
+        }
+
+        ~LinkedListShared() {
+            clear();
+        }
+
+        void pushFront(const T& value) {
+            emplaceFront(value);
+        }
+
+        void pushFront(T&& value) {
+            emplaceFront(std::move(value));
+        }
 
-        void pushFront(T value) {
-            SharedPtr<Node> newNode(new Node(value));
-            newNode->next = head;
-            head = newNode;
+        // Значение создается в узле из args, без промежуточных копий
+        template <typename... Args>
+        const T& emplaceFront(Args&&... args) {
+            head = allocateShared<Node>(alloc, head, std::forward<Args>(args)...);
+            return head->data;
+        }
+
+        // Перенос первого узла other в начало списка. Узел перевязывается, если его не видит
+        // копия other, иначе значение копируется в новый узел. O(1)
+        void transferFront(LinkedListShared& other) {
+            if (this == &other || !other.head) {
+                return;
+            }
+            SharedPtr<Node> node = takeFirst(other);
+            node.get()->next = std::move(head);
+            head = std::move(node);
+        }
+
+        // Перенос первого узла other сразу после pos.
+        // pos - разыменуемый итератор этого списка (не end()), как у std::forward_list::splice_after.
+        // Если узлы до pos видит копия списка, они копируются, чтобы копия не изменилась:
+        // итераторы на них продолжают указывать в копию. Без копий списка - O(1)
+        void transferAfter(const_iterator pos, LinkedListShared& other) {
+            assert(pos.node && ownsNode(pos.node) && "pos должен указывать на узел этого списка");
+            if (this == &other || !other.head) {
+                return;
+            }
+            Node* target = privateNode(pos.node);
+            SharedPtr<Node> node = takeFirst(other);
+            node.get()->next = std::move(target->next);
+            target->next = std::move(node);
+        }
+
+        // Все узлы other перед первым элементом списка; other становится пустым.
+        // Цепочка перевязывается, если ни один ее узел не виден копиям other, иначе копируется
+        void spliceFront(LinkedListShared& other) {
+            if (this == &other || !other.head) {
+                return;
+            }
+            Node* tail = nullptr;
+            SharedPtr<Node> chain = takeChain(other, tail);
+            tail->next = std::move(head);
+            head = std::move(chain);
+        }
+
+        // Все узлы other сразу после pos; other становится пустым.
+        // pos и копирование узлов - как у transferAfter
+        void spliceAfter(const_iterator pos, LinkedListShared& other) {
+            assert(pos.node && ownsNode(pos.node) && "pos должен указывать на узел этого списка");
+            if (this == &other || !other.head) {
+                return;
+            }
+            Node* target = privateNode(pos.node);
+            Node* tail = nullptr;
+            SharedPtr<Node> chain = takeChain(other, tail);
+            tail->next = std::move(target->next);
+            target->next = std::move(chain);
+        }
+
+        // Замена содержимого элементами [first, last) в том же порядке. Узлы пристраиваются
+        // к хвосту; диапазон с произвольным доступом и std::allocator позволяют строить
+        // отрезки в нескольких потоках. Копии списка сохраняют старые узлы
+        template <typename It>
+        void assign(It first, It last) {
+            parallelAssign(detail::hardwareThreads(), first, last);
+        }
+
+        // assign не более чем в threads потоках; с пулом или ареной - в текущем потоке
+        template <typename It>
+        void parallelAssign(unsigned threads, It first, It last) {
+            using Category = typename std::iterator_traits<It>::iterator_category;
+            constexpr bool splittable = std::is_base_of<std::random_access_iterator_tag, Category>::value &&
+                                        std::allocator_traits<Alloc>::is_always_equal::value;
+            const std::size_t length = splittable ? static_cast<std::size_t>(std::distance(first, last)) : 0;
+            const std::size_t runs = detail::parallelRuns(length, threads);
+            Node* tail = nullptr;
+            SharedPtr<Node> chain;
+
+            if constexpr (splittable) {
+                if (runs > 1) {
+                    // Счетчики узлов не атомарны, но до сшивания каждый узел видит один поток
+                    std::vector<SharedPtr<Node>> parts(runs);
+                    std::vector<Node*> tails(runs, nullptr);
+                    try {
+                        detail::runJobs(runs, [this, &parts, &tails, first, length, runs](std::size_t i) {
+                            It begin = first;
+                            for (std::size_t j = 0; j < i; ++j) {
+                                begin += detail::runLength(length, runs, j);
+                            }
+                            parts[i] = buildChain(begin, begin + detail::runLength(length, runs, i), tails[i]);
+                        });
+                    } catch (...) {
+                        for (auto& part : parts) {
+                            destroyChain(part);
+                        }
+                        throw;
+                    }
+                    for (std::size_t i = runs - 1; i > 0; --i) {
+                        tails[i - 1]->next = std::move(parts[i]);
+                    }
+                    chain = std::move(parts[0]);
+                }
+            }
+            if (!chain) {
+                chain = buildChain(first, last, tail);
+            }
+
+            clear();
+            head = std::move(chain);
         }
 
         void print() const {
@@ -43,17 +361,35 @@ namespace SmartPointer {
             }
         }
 
-        bool find(T value) const {
-            SharedPtr<Node> current = head;
-            while (current) {
+        // Удаление узлов циклом, без рекурсии через деструкторы SharedPtr.
+        // Узлы, на которые еще ссылается копия списка, остаются ей
+        void clear() {
+            SharedPtr<Node> current = std::move(head);
+            while (current && current.useCount() == 1) {
+                current = current->next;
+            }
+        }
+
+        // Обход по сырым указателям, как в count: копия SharedPtr на каждом шаге меняла бы счетчики
+        bool find(const T& value) const {
+            for (const Node* current = head.get(); current != nullptr; current = current->next.get()) {
                 if (current->data == value) {
                     return true;
                 }
-                current = current->next;
             }
             return false;
         }
+
+        std::size_t count(const T& value) const {
+            std::size_t result = 0;
+            const Node* current = head.get();
+            while (current != nullptr) {
+                result += current->data == value;
+                current = current->next.get();
+            }
+            return result;
+        }
     };
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -4,32 +4,436 @@
 #define LINKED_LIST_UNIQUE_PTR_H
 
 #include "UniquePtr.hpp" 
+#include "NodePool.hpp"
+#include "EpochReclaim.hpp"
+#include "ParallelJobs.hpp"
+#include <atomic>  // Опубликованная голова для читателей из других потоков
+#include <cassert>
+#include <cstddef> // Для std::size_t
+#include <functional> // Для std::less
 #include <iostream>
+#include <iterator> // Для std::forward_iterator_tag
+#include <memory> // Для std::allocator и std::allocator_traits
+#include <type_traits>
+#include <utility> // Для std::move и std::forward
+#include <vector>
 
 namespace SmartPointer {
 
-    template <typename T>
+    // Alloc - аллокатор узлов (std::allocator, PoolAllocator или ArenaAllocator из NodePool.hpp).
+    // Reclaim - ImmediateReclaim или EpochReclaim (EpochReclaim.hpp): во втором случае
+    // find, count и print можно вызывать из других потоков одновременно с изменением списка
+    // одним писателем, а снятые узлы освобождаются, когда их уже не видит ни один читатель
+    template <typename T, typename Alloc = std::allocator<T>, typename Reclaim = ImmediateReclaim>
     class LinkedListUnique {
     private:
+        struct Node;
+
+        using NodeAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+        using NodeTraits = std::allocator_traits<NodeAlloc>;
+
+        // Возвращает узел аллокатору; для std::allocator не занимает места в UniquePtr
+        struct NodeDeleter : NodeAlloc {
+            NodeDeleter() = default;
+            explicit NodeDeleter(const NodeAlloc& alloc) : NodeAlloc(alloc) {}
+
+            void operator()(Node* node) {
+                NodeTraits::destroy(*this, node);
+                NodeTraits::deallocate(*this, node, 1);
+            }
+        };
+
+        using NodePtr = UniquePtr<Node, NodeDeleter>;
+
         struct Node {
             T data;
-            UniquePtr<Node> next;
-            Node(T value) : data(value), next(nullptr) {}
+            NodePtr next;
+            // Значение создается прямо в узле из аргументов emplaceFront/pushFront
+            template <typename... Args>
+            explicit Node(NodePtr&& next, Args&&... args)
+                : data(std::forward<Args>(args)...), next(std::move(next)) {}
+        };
+
+        static constexpr bool deferredReclaim = std::is_same<Reclaim, EpochReclaim>::value;
+
+        // Арена или пул, принадлежащий списку, освобождают память узлов разом,
+        // а тривиальные данные не требуют деструктора
+        static constexpr bool skipNodeTeardown =
+            IsBulkReleaseAllocator<NodeAlloc>::value && std::is_trivially_destructible<T>::value;
+
+        // Снятый узел еще владеет следующим (читатель мог остановиться на нем), поэтому
+        // перед удалением связь разрывается: остальная цепочка принадлежит списку
+        struct RetireNode : NodeDeleter {
+            RetireNode() = default;
+            explicit RetireNode(const NodeAlloc& alloc) : NodeDeleter(alloc) {}
+
+            void operator()(Node* node) {
+                node->next.release();
+                NodeDeleter::operator()(node);
+            }
+        };
+
+        // Голова для читателей и снятые узлы - только при EpochReclaim
+        struct EpochState {
+            std::atomic<Node*> published{nullptr};
+            RetiredList<Node, RetireNode> retired;
+
+            explicit EpochState(const NodeAlloc& alloc) : retired(RetireNode(alloc)) {}
+        };
+
+        struct NoState {
+            explicit NoState(const NodeAlloc&) {}
+        };
+
+        // Без EpochReclaim обход ничего не объявляет
+        struct NoGuard {
+            NoGuard() {}
+        };
+        using EpochReadGuard = std::conditional_t<deferredReclaim, EpochGuard, NoGuard>;
+
+        NodeAlloc alloc;
+        NodePtr head;
+        std::conditional_t<deferredReclaim, EpochState, NoState> reclaim;
+
+        void publish() {
+            if constexpr (deferredReclaim) {
+                reclaim.published.store(head.get(), std::memory_order_seq_cst);
+            }
+        }
+
+        // Начало обхода: при EpochReclaim - опубликованная голова, ее узлы не меняются
+        const Node* first() const {
+            if constexpr (deferredReclaim) {
+                return reclaim.published.load(std::memory_order_seq_cst);
+            } else {
+                return head.get();
+            }
+        }
+
+        template <typename... Args>
+        NodePtr createNode(NodePtr&& next, Args&&... args) {
+            Node* node = NodeTraits::allocate(alloc, 1);
+            try {
+                NodeTraits::construct(alloc, node, std::move(next), std::forward<Args>(args)...);
+            } catch (...) {
+                NodeTraits::deallocate(alloc, node, 1);
+                throw;
+            }
+            return NodePtr(node, NodeDeleter(alloc));
+        }
+
+        // Прямой итератор по узлам. При EpochReclaim - только для потока-писателя
+        template <bool Const>
+        class Iterator {
+        private:
+            using NodeType = std::conditional_t<Const, const Node, Node>;
+
+            NodeType* node;
+
+            friend class LinkedListUnique;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<Const, const T*, T*>;
+            using reference = std::conditional_t<Const, const T&, T&>;
+
+            Iterator() : node(nullptr) {}
+            explicit Iterator(NodeType* n) : node(n) {}
+
+            // Изменяемый итератор приводится к константному
+            template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+            Iterator(const Iterator<OtherConst>& other) : node(other.node) {}
+
+            reference operator*() const {
+                return node->data;
+            }
+
+            pointer operator->() const {
+                return &node->data;
+            }
+
+            Iterator& operator++() {
+                node = node->next.get();
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                Iterator old = *this;
+                node = node->next.get();
+                return old;
+            }
+
+            friend bool operator==(const Iterator& a, const Iterator& b) {
+                return a.node == b.node;
+            }
+
+            friend bool operator!=(const Iterator& a, const Iterator& b) {
+                return a.node != b.node;
+            }
         };
 
-        UniquePtr<Node> head;
+        // Последний узел цепочки, начинающейся с first (first не пуст)
+        static Node* lastNode(Node* first) {
+            while (first->next) {
+                first = first->next.get();
+            }
+            return first;
+        }
+
+        // Для проверок в отладочной сборке: node - узел этого списка. O(n)
+        bool ownsNode(const Node* node) const {
+            for (const Node* current = head.get(); current != nullptr; current = current->next.get()) {
+                if (current == node) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        static std::size_t chainLength(const Node* first) {
+            std::size_t length = 0;
+            for (; first != nullptr; first = first->next.get()) {
+                ++length;
+            }
+            return length;
+        }
+
+        // Снять первый узел цепочки. Узел уходит вместе с удалителем, поэтому сортировка
+        // и слияние не путают узлы разных аллокаторов
+        static NodePtr takeFirst(NodePtr& chain) {
+            NodePtr node = std::move(chain);
+            chain = std::move(node->next);
+            return node;
+        }
+
+        // Вернуть цепочку part в начало chain (при исключении сравнения)
+        static void restoreChain(NodePtr& chain, NodePtr& part) {
+            if (part) {
+                lastNode(part.get())->next = std::move(chain);
+                chain = std::move(part);
+            }
+        }
+
+        // Слияние отсортированных цепочек into и from в into; из равных первым идет узел into.
+        // Если comp бросает исключение, все узлы остаются в into, порядок не определен
+        template <typename Compare>
+        static void mergeChains(NodePtr& into, NodePtr& from, Compare& comp) {
+            if (!from) {
+                return;
+            }
+            if (!into) {
+                into = std::move(from);
+                return;
+            }
+            NodePtr result = comp(from->data, into->data) ? takeFirst(from) : takeFirst(into);
+            Node* last = result.get();
+            try {
+                while (into && from) {
+                    last->next = comp(from->data, into->data) ? takeFirst(from) : takeFirst(into);
+                    last = last->next.get();
+                }
+            } catch (...) {
+                last->next = std::move(into);
+                lastNode(last)->next = std::move(from);
+                into = std::move(result);
+                throw;
+            }
+            last->next = into ? std::move(into) : std::move(from);
+            into = std::move(result);
+        }
+
+        // Сортировка первых length узлов chain слиянием; chain переходит к оставшимся узлам.
+        // Половины сортируются по мере снятия узлов, поэтому цепочка проходится без
+        // отдельных проходов для разбиения, а глубина рекурсии - log2(length)
+        template <typename Compare>
+        static NodePtr sortChain(NodePtr& chain, std::size_t length, Compare& comp) {
+            if (length == 1) {
+                return takeFirst(chain);
+            }
+            const std::size_t half = length / 2;
+            NodePtr left = sortChain(chain, half, comp);
+            NodePtr right(nullptr, left.getDeleter());
+            try {
+                right = sortChain(chain, length - half, comp);
+                mergeChains(left, right, comp);
+            } catch (...) {
+                restoreChain(chain, right);
+                restoreChain(chain, left);
+                throw;
+            }
+            return left;
+        }
+
+        // Удаление цепочки циклом (деструктор UniquePtr прошел бы ее рекурсивно)
+        static void destroyChain(NodePtr& chain) {
+            while (chain) {
+                chain = std::move(chain->next);
+            }
+        }
+
+        // Цепочка из [first, last) в том же порядке; tail - ее последний узел
+        template <typename It>
+        NodePtr buildChain(It first, It last, Node*& tail) {
+            NodePtr chain(nullptr, NodeDeleter(alloc));
+            NodePtr* link = &chain;
+            tail = nullptr;
+            try {
+                for (; first != last; ++first) {
+                    *link = createNode(NodePtr(nullptr, NodeDeleter(alloc)), *first);
+                    tail = link->get();
+                    link = &tail->next;
+                }
+            } catch (...) {
+                destroyChain(chain);
+                throw;
+            }
+            return chain;
+        }
 
     public:
-        LinkedListUnique() : head(nullptr) {}
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        iterator begin() {
+            return iterator(head.get());
+        }
 
-        void pushFront(T value) {
-            UniquePtr<Node> newNode(new Node(value));
-            newNode->next = std::move(head);
-            head = std::move(newNode);
+        iterator end() {
+            return iterator();
+        }
+
+        const_iterator begin() const {
+            return const_iterator(head.get());
+        }
+
+        const_iterator end() const {
+            return const_iterator();
+        }
+
+        const_iterator cbegin() const {
+            return begin();
+        }
+
+        const_iterator cend() const {
+            return end();
+        }
+
+        LinkedListUnique() : alloc(), head(nullptr, NodeDeleter(alloc)), reclaim(alloc) {}
+
+        explicit LinkedListUnique(const Alloc& allocator)
+            : alloc(allocator), head(nullptr, NodeDeleter(alloc)), reclaim(alloc) {}
+
+        // Список из [first, last) в том же порядке (см. assign)
+        template <typename It, typename = std::enable_if_t<!std::is_integral<It>::value>>
+        LinkedListUnique(It first, It last, const Alloc& allocator = Alloc())
+            : LinkedListUnique(allocator) {
+            assign(first, last);
+        }
+
+        template <typename Range>
+        static LinkedListUnique fromRange(const Range& range, const Alloc& allocator = Alloc()) {
+            return LinkedListUnique(std::begin(range), std::end(range), allocator);
+        }
+
+        // Список с читателями в других потоках не перемещается
+        LinkedListUnique(LinkedListUnique&& other) = default;
+
+        LinkedListUnique& operator=(LinkedListUnique&& other) {
+            static_assert(!deferredReclaim, "Список с EpochReclaim не перемещается");
+            if (this != &other) {
+                clear();
+                alloc = std::move(other.alloc);
+                head = std::move(other.head);
+            }
+            return *this;
+        }
+
+        // Читателей в других потоках к этому моменту быть не должно
+        ~LinkedListUnique() {
+            clear();
+            if constexpr (deferredReclaim) {
+                reclaim.retired.drain();
+            }
+        }
+
+        void pushFront(const T& value) {
+            emplaceFront(value);
+        }
+
+        void pushFront(T&& value) {
+            emplaceFront(std::move(value));
+        }
+
+        // Значение создается в узле из args, без промежуточных копий
+        template <typename... Args>
+        T& emplaceFront(Args&&... args) {
+            head = createNode(std::move(head), std::forward<Args>(args)...);
+            publish();
+            return head->data;
+        }
+
+        // Замена содержимого элементами [first, last) в том же порядке. Узлы пристраиваются
+        // к хвосту, без pushFront и разворота. Диапазон с произвольным доступом и аллокатор
+        // без состояния (std::allocator) позволяют строить отрезки в нескольких потоках
+        template <typename It>
+        void assign(It first, It last) {
+            parallelAssign(detail::hardwareThreads(), first, last);
+        }
+
+        // assign не более чем в threads потоках. Пулы и арены не потокобезопасны,
+        // поэтому с ними список строится в текущем потоке (память они и так берут кусками)
+        template <typename It>
+        void parallelAssign(unsigned threads, It first, It last) {
+            using Category = typename std::iterator_traits<It>::iterator_category;
+            constexpr bool splittable = std::is_base_of<std::random_access_iterator_tag, Category>::value &&
+                                        NodeTraits::is_always_equal::value;
+            const std::size_t length = splittable ? static_cast<std::size_t>(std::distance(first, last)) : 0;
+            const std::size_t runs = detail::parallelRuns(length, threads);
+            Node* tail = nullptr;
+            NodePtr chain(nullptr, NodeDeleter(alloc));
+
+            if constexpr (splittable) {
+                if (runs > 1) {
+                    // Отрезки строятся независимо и сшиваются по порядку
+                    std::vector<NodePtr> parts;
+                    std::vector<Node*> tails(runs, nullptr);
+                    for (std::size_t i = 0; i < runs; ++i) {
+                        parts.emplace_back(nullptr, NodeDeleter(alloc));
+                    }
+                    try {
+                        detail::runJobs(runs, [this, &parts, &tails, first, length, runs](std::size_t i) {
+                            It begin = first;
+                            for (std::size_t j = 0; j < i; ++j) {
+                                begin += detail::runLength(length, runs, j);
+                            }
+                            parts[i] = buildChain(begin, begin + detail::runLength(length, runs, i), tails[i]);
+                        });
+                    } catch (...) {
+                        for (auto& part : parts) {
+                            destroyChain(part);
+                        }
+                        throw;
+                    }
+                    for (std::size_t i = runs - 1; i > 0; --i) {
+                        tails[i - 1]->next = std::move(parts[i]);
+                    }
+                    chain = std::move(parts[0]);
+                }
+            }
+            if (!chain) {
+                chain = buildChain(first, last, tail);
+            }
+
+            clear();
+            head = std::move(chain);
+            publish();
         }
 
         void print() const {
-            const Node* current = head.get();
+            EpochReadGuard guard;
+            const Node* current = first();
             while (current != nullptr) {
                 std::cout << current->data << " -> ";
                 current = current->next.get();
@@ -38,13 +442,191 @@ namespace SmartPointer {
         }
 
         void popFront() {
-            if (head) {
+            if (!head) {
+                return;
+            }
+            if constexpr (deferredReclaim) {
+                // Поле next снятого узла не трогаем: по нему еще может идти читатель
+                Node* old = head.release();
+                head.reset(old->next.get());
+                publish();
+                reclaim.retired.retire(old);
+            } else {
                 head = std::move(head->next);
             }
         }
 
-        bool find(T value) const {
-            const Node* current = head.get();
+        // Перенос первого узла other в начало списка: узел перевязывается, значение не копируется.
+        // Узел уходит вместе со своим удалителем, поэтому аллокаторы списков могут различаться
+        // (при ArenaAllocator память узла остается в арене other). O(1)
+        void transferFront(LinkedListUnique& other) {
+            static_assert(!deferredReclaim, "Перевязка узлов несовместима с читателями EpochReclaim");
+            if (this == &other || !other.head) {
+                return;
+            }
+            NodePtr node = std::move(other.head);
+            other.head = std::move(node->next);
+            node->next = std::move(head);
+            head = std::move(node);
+        }
+
+        // Перенос первого узла other сразу после pos. O(1).
+        // pos - разыменуемый итератор этого списка (не end()), как у std::forward_list::splice_after
+        void transferAfter(const_iterator pos, LinkedListUnique& other) {
+            static_assert(!deferredReclaim, "Перевязка узлов несовместима с читателями EpochReclaim");
+            assert(pos.node && ownsNode(pos.node) && "pos должен указывать на узел этого списка");
+            if (this == &other || !other.head) {
+                return;
+            }
+            Node* target = const_cast<Node*>(pos.node);
+            NodePtr node = std::move(other.head);
+            other.head = std::move(node->next);
+            node->next = std::move(target->next);
+            target->next = std::move(node);
+        }
+
+        // Все узлы other перед первым элементом списка; other становится пустым.
+        // Копий нет, но для поиска хвоста other проходится целиком
+        void spliceFront(LinkedListUnique& other) {
+            static_assert(!deferredReclaim, "Перевязка узлов несовместима с читателями EpochReclaim");
+            if (this == &other || !other.head) {
+                return;
+            }
+            lastNode(other.head.get())->next = std::move(head);
+            head = std::move(other.head);
+        }
+
+        // Все узлы other сразу после pos; pos - разыменуемый итератор этого списка (не end())
+        void spliceAfter(const_iterator pos, LinkedListUnique& other) {
+            static_assert(!deferredReclaim, "Перевязка узлов несовместима с читателями EpochReclaim");
+            assert(pos.node && ownsNode(pos.node) && "pos должен указывать на узел этого списка");
+            if (this == &other || !other.head) {
+                return;
+            }
+            Node* target = const_cast<Node*>(pos.node);
+            lastNode(other.head.get())->next = std::move(target->next);
+            target->next = std::move(other.head);
+        }
+
+        // Сортировка перевязкой узлов, без выделения памяти и копирования значений; устойчивая.
+        // Длинный список делится на отрезки, которые сортируются параллельно и затем сливаются
+        template <typename Compare = std::less<T>>
+        void sort(Compare comp = Compare()) {
+            parallelSort(detail::hardwareThreads(), std::move(comp));
+        }
+
+        // Сортировка не более чем в threads потоках, по отрезку не короче detail::minParallelRun.
+        // comp копируется в каждый поток. Если comp бросает исключение, все элементы
+        // остаются в списке, но порядок не определен
+        template <typename Compare = std::less<T>>
+        void parallelSort(unsigned threads, Compare comp = Compare()) {
+            static_assert(!deferredReclaim, "Перевязка узлов несовместима с читателями EpochReclaim");
+            const std::size_t length = chainLength(head.get());
+            if (length < 2) {
+                return;
+            }
+            const std::size_t runs = detail::parallelRuns(length, threads);
+            if (runs <= 1) {
+                NodePtr sorted = sortChain(head, length, comp);
+                head = std::move(sorted);
+                return;
+            }
+
+            // Отрезки почти равной длины; каждый поток сортирует свой, узлы потоки не делят
+            std::vector<NodePtr> parts;
+            parts.reserve(runs);
+            for (std::size_t i = 0; i < runs; ++i) {
+                const std::size_t partLength = detail::runLength(length, runs, i);
+                Node* last = head.get();
+                for (std::size_t j = 1; j < partLength; ++j) {
+                    last = last->next.get();
+                }
+                parts.push_back(std::move(head));
+                head = std::move(last->next);
+            }
+
+            try {
+                detail::runJobs(runs, [&parts, &comp, length, runs](std::size_t i) {
+                    Compare localComp(comp);
+                    NodePtr chain = std::move(parts[i]);
+                    try {
+                        parts[i] = sortChain(chain, detail::runLength(length, runs, i), localComp);
+                    } catch (...) {
+                        parts[i] = std::move(chain);
+                        throw;
+                    }
+                });
+
+                // Соседние отрезки сливаются попарно, пока не останется один; порядок отрезков
+                // сохраняется, поэтому сортировка остается устойчивой
+                for (std::size_t step = 1; step < runs; step *= 2) {
+                    const std::size_t pairs = (runs + 2 * step - 1) / (2 * step);
+                    detail::runJobs(pairs, [&parts, &comp, step, runs](std::size_t pair) {
+                        const std::size_t left = pair * 2 * step;
+                        if (left + step < runs) {
+                            Compare localComp(comp);
+                            mergeChains(parts[left], parts[left + step], localComp);
+                        }
+                    });
+                }
+            } catch (...) {
+                for (auto& part : parts) {
+                    restoreChain(head, part);
+                }
+                throw;
+            }
+            head = std::move(parts[0]);
+        }
+
+        // Слияние с отсортированным other перевязкой узлов; other становится пустым.
+        // Из равных элементов первыми идут элементы этого списка. O(n + m)
+        template <typename Compare = std::less<T>>
+        void merge(LinkedListUnique& other, Compare comp = Compare()) {
+            static_assert(!deferredReclaim, "Перевязка узлов несовместима с читателями EpochReclaim");
+            if (this != &other) {
+                mergeChains(head, other.head, comp);
+            }
+        }
+
+        // Освободить снятые узлы, которые уже не видит ни один читатель
+        void collectRetired() {
+            if constexpr (deferredReclaim) {
+                reclaim.retired.collect();
+            }
+        }
+
+        std::size_t retiredCount() const {
+            if constexpr (deferredReclaim) {
+                return reclaim.retired.size();
+            } else {
+                return 0;
+            }
+        }
+
+        // Удаление всех узлов циклом: деструктор UniquePtr рекурсивно прошел бы
+        // всю цепочку и на длинных списках переполнил бы стек
+        void clear() {
+            if constexpr (deferredReclaim) {
+                while (head) {
+                    popFront();
+                }
+            } else if constexpr (skipNodeTeardown) {
+                // Цепочка не обходится: память узлов вернет владелец арены или сразу пул списка.
+                // Пустой список (например, после переноса) ресурс не трогает
+                if (head) {
+                    head.release();
+                    releaseAbandonedNodes(alloc);
+                }
+            } else {
+                while (head) {
+                    head = std::move(head->next);
+                }
+            }
+        }
+
+        bool find(const T& value) const {
+            EpochReadGuard guard;
+            const Node* current = first();
             while (current != nullptr) {
                 if (current->data == value) {
                     return true;
@@ -53,7 +635,18 @@ namespace SmartPointer {
             }
             return false;
         }
+
+        std::size_t count(const T& value) const {
+            EpochReadGuard guard;
+            std::size_t result = 0;
+            const Node* current = first();
+            while (current != nullptr) {
+                result += current->data == value;
+                current = current->next.get();
+            }
+            return result;
+        }
     };
 }
 
-#endif
\ No newline at end of file
+#endif
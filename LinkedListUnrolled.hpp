@@ -0,0 +1,144 @@
+#pragma once
+
+#ifndef LINKED_LIST_UNROLLED_H
+#define LINKED_LIST_UNROLLED_H
+
+#include "UniquePtr.hpp"
+#include "SimdSearch.hpp"
+#include <cstddef> // Для std::size_t
+#include <iostream>
+#include <new>     // Для placement new
+#include <utility> // Для std::move
+
+namespace SmartPointer {
+
+    // Число элементов в узле по умолчанию: около 256 байт данных на узел
+    template <typename T>
+    constexpr std::size_t defaultUnrolledChunk() {
+        return sizeof(T) >= 64 ? 4 : 256 / sizeof(T);
+    }
+
+    // Развернутый список: каждый узел хранит небольшой массив элементов,
+    // поэтому обход делает один переход по указателю на ChunkSize элементов
+    template <typename T, std::size_t ChunkSize = defaultUnrolledChunk<T>()>
+    class LinkedListUnrolled {
+    private:
+        static_assert(ChunkSize > 0, "В узле должен помещаться хотя бы один элемент");
+
+        // Элементы узла занимают ячейки [begin, ChunkSize): pushFront заполняет массив с конца
+        struct Node {
+            std::size_t begin = ChunkSize;
+            alignas(T) unsigned char storage[ChunkSize * sizeof(T)];
+            UniquePtr<Node> next;
+
+            explicit Node(UniquePtr<Node>&& next) : next(std::move(next)) {}
+
+            Node(const Node&) = delete;
+            Node& operator=(const Node&) = delete;
+
+            ~Node() {
+                for (std::size_t i = begin; i < ChunkSize; ++i) {
+                    items()[i].~T();
+                }
+            }
+
+            T* items() {
+                return reinterpret_cast<T*>(storage);
+            }
+
+            const T* items() const {
+                return reinterpret_cast<const T*>(storage);
+            }
+
+            bool full() const {
+                return begin == 0;
+            }
+        };
+
+        UniquePtr<Node> head;
+
+    public:
+        LinkedListUnrolled() : head(nullptr) {}
+
+        LinkedListUnrolled(LinkedListUnrolled&& other) = default;
+
+        LinkedListUnrolled& operator=(LinkedListUnrolled&& other) {
+            if (this != &other) {
+                clear();
+                head = std::move(other.head);
+            }
+            return *this;
+        }
+
+        ~LinkedListUnrolled() {
+            clear();
+        }
+
+        void pushFront(T value) {
+            if (head && !head->full()) {
+                ::new (static_cast<void*>(head->items() + head->begin - 1)) T(value);
+                --head->begin;
+                return;
+            }
+            // Новый узел попадает в список только с элементом: пустых узлов в цепочке не бывает
+            UniquePtr<Node> node(new Node(UniquePtr<Node>()));
+            ::new (static_cast<void*>(node->items() + ChunkSize - 1)) T(value);
+            node->begin = ChunkSize - 1;
+            node->next = std::move(head);
+            head = std::move(node);
+        }
+
+        void print() const {
+            const Node* current = head.get();
+            while (current != nullptr) {
+                for (std::size_t i = current->begin; i < ChunkSize; ++i) {
+                    std::cout << current->items()[i] << " -> ";
+                }
+                current = current->next.get();
+            }
+            std::cout << "nullptr" << std::endl;
+        }
+
+        void popFront() {
+            if (head) {
+                head->items()[head->begin].~T();
+                ++head->begin;
+                if (head->begin == ChunkSize) {
+                    head = std::move(head->next);
+                }
+            }
+        }
+
+        // Элементы узла лежат подряд, поэтому для числовых типов сравнение идет векторно
+        bool find(T value) const {
+            const Node* current = head.get();
+            while (current != nullptr) {
+                const std::size_t size = ChunkSize - current->begin;
+                if (SimdSearch::find(current->items() + current->begin, size, value) != size) {
+                    return true;
+                }
+                current = current->next.get();
+            }
+            return false;
+        }
+
+        std::size_t count(T value) const {
+            std::size_t result = 0;
+            const Node* current = head.get();
+            while (current != nullptr) {
+                result += SimdSearch::count(current->items() + current->begin, ChunkSize - current->begin, value);
+                current = current->next.get();
+            }
+            return result;
+        }
+
+        // Удаление всех узлов циклом, без рекурсии через деструкторы UniquePtr
+        void clear() {
+            while (head) {
+                head = std::move(head->next);
+            }
+        }
+    };
+}
+
+#endif
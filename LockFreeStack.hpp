@@ -0,0 +1,72 @@
+#pragma once
+
+#ifndef LOCK_FREE_STACK_H
+#define LOCK_FREE_STACK_H
+
+#include "AtomicSharedPtr.hpp"
+#include <utility> // Для std::move
+
+namespace SmartPointer {
+
+    // Стек на односвязном списке, с которым потоки работают без блокировок.
+    // Вершина - AtomicSharedPtr, поэтому узел, который поток прочитал как вершину,
+    // не освобождается и не переиспользуется до конца его операции: сравнение
+    // в compareExchange не может спутать старый узел с новым по тому же адресу (ABA)
+    template <typename T>
+    class LockFreeStack {
+    private:
+        struct Node {
+            T data;
+            ConcurrentSharedPtr<Node> next; // После публикации узла не меняется
+
+            explicit Node(T value) : data(std::move(value)) {}
+        };
+
+        AtomicSharedPtr<Node> head;
+
+    public:
+        LockFreeStack() = default;
+
+        LockFreeStack(const LockFreeStack&) = delete;
+        LockFreeStack& operator=(const LockFreeStack&) = delete;
+
+        ~LockFreeStack() {
+            clear();
+        }
+
+        void pushFront(T value) {
+            ConcurrentSharedPtr<Node> node = makeShared<Node, AtomicRefCount>(std::move(value));
+            ConcurrentSharedPtr<Node> top = head.load();
+            do {
+                node.get()->next = top; // Узел еще не виден другим потокам
+            } while (!head.compareExchange(top, node));
+        }
+
+        // false - стек пуст
+        bool popFront(T& value) {
+            ConcurrentSharedPtr<Node> top = head.load();
+            while (top && !head.compareExchange(top, top->next)) {
+            }
+            if (!top) {
+                return false;
+            }
+            value = top->data;
+            return true;
+        }
+
+        bool empty() const {
+            return !head.load();
+        }
+
+        // Снятие узлов по одному, без рекурсии через деструкторы SharedPtr.
+        // Узел, который еще держит другой поток, остается ему вместе с хвостом
+        void clear() {
+            ConcurrentSharedPtr<Node> current = head.exchange(ConcurrentSharedPtr<Node>());
+            while (current && current.useCount() == 1) {
+                current = current->next;
+            }
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,159 @@
+#pragma once
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>     // Для std::size_t
+#include <fstream>
+#include <stdexcept>   // Для std::runtime_error
+#include <string>
+#include <utility>     // Для std::exchange
+
+#include "UniquePtr.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>     // open
+#include <sys/mman.h>  // mmap, madvise, msync
+#include <sys/stat.h>  // fstat
+#include <unistd.h>    // ftruncate, close
+#define SMART_POINTER_HAS_MMAP 1
+#endif
+
+// Файл, отображенный в память целиком. ReadOnly - закрытое отображение только для чтения
+// (снимки); без mmap файл читается в память. ReadWrite - общее отображение MAP_SHARED:
+// записи видят все процессы, отобразившие тот же файл (сегменты); без mmap не поддерживается
+class MappedFile {
+public:
+    enum Mode { ReadOnly, ReadWrite };
+
+private:
+    unsigned char* bytes = nullptr;
+    std::size_t length = 0;
+    UniquePtr<unsigned char[]> buffer; // Только без mmap
+
+    void unmap() {
+#ifdef SMART_POINTER_HAS_MMAP
+        if (bytes != nullptr && !buffer) {
+            munmap(bytes, length);
+        }
+#endif
+        bytes = nullptr;
+        length = 0;
+        buffer = UniquePtr<unsigned char[]>();
+    }
+
+#ifdef SMART_POINTER_HAS_MMAP
+    // flags открытия соответствуют mode; size, если задан, - новый размер файла
+    void map(const std::string& path, Mode mode, int flags, const std::size_t* size) {
+        const int fd = ::open(path.c_str(), flags, 0644);
+        if (fd < 0) {
+            throw std::runtime_error("Не удалось открыть файл " + path);
+        }
+        struct stat info;
+        if ((size && ftruncate(fd, static_cast<off_t>(*size)) != 0) || fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Не удалось задать или прочитать размер файла " + path);
+        }
+        length = static_cast<std::size_t>(info.st_size);
+        if (length > 0) {
+            void* mapped = mode == ReadWrite ? mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+                                             : mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Не удалось отобразить файл " + path);
+            }
+            bytes = static_cast<unsigned char*>(mapped);
+        }
+        ::close(fd); // Отображение остается действительным и после закрытия файла
+    }
+#endif
+
+public:
+    MappedFile() = default;
+
+    // Существующий файл
+    explicit MappedFile(const std::string& path, Mode mode = ReadOnly) {
+#ifdef SMART_POINTER_HAS_MMAP
+        map(path, mode, mode == ReadWrite ? O_RDWR : O_RDONLY, nullptr);
+#else
+        if (mode == ReadWrite) {
+            throw std::runtime_error("Отображение файлов не поддерживается на этой платформе");
+        }
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            throw std::runtime_error("Не удалось открыть файл " + path);
+        }
+        length = static_cast<std::size_t>(file.tellg());
+        buffer = UniquePtr<unsigned char[]>(new unsigned char[length]);
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(buffer.get()), static_cast<std::streamsize>(length));
+        bytes = buffer.get();
+#endif
+    }
+
+    // Новый файл размером size байт, заполненный нулями, в режиме ReadWrite;
+    // старое содержимое файла теряется
+    static MappedFile create(const std::string& path, std::size_t size) {
+#ifdef SMART_POINTER_HAS_MMAP
+        MappedFile file;
+        file.map(path, ReadWrite, O_RDWR | O_CREAT | O_TRUNC, &size);
+        return file;
+#else
+        (void)path;
+        (void)size;
+        throw std::runtime_error("Отображение файлов не поддерживается на этой платформе");
+#endif
+    }
+
+    MappedFile(MappedFile&& other) noexcept
+        : bytes(std::exchange(other.bytes, nullptr)), length(std::exchange(other.length, 0)),
+          buffer(std::move(other.buffer)) {}
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            bytes = std::exchange(other.bytes, nullptr);
+            length = std::exchange(other.length, 0);
+            buffer = std::move(other.buffer);
+        }
+        return *this;
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        unmap();
+    }
+
+    // Файл будет прочитан один раз от начала до конца: ядро может читать с опережением
+    void adviseSequential() {
+#ifdef SMART_POINTER_HAS_MMAP
+        if (bytes != nullptr && !buffer) {
+            // Советы - не битовые флаги, поэтому каждый передается отдельным вызовом
+            madvise(bytes, length, MADV_SEQUENTIAL);
+            madvise(bytes, length, MADV_WILLNEED);
+        }
+#endif
+    }
+
+    // Записать изменения отображения ReadWrite на диск
+    void flush() {
+#ifdef SMART_POINTER_HAS_MMAP
+        if (bytes != nullptr && !buffer) {
+            msync(bytes, length, MS_SYNC);
+        }
+#endif
+    }
+
+    // Изменять байты можно только в режиме ReadWrite
+    unsigned char* data() const {
+        return bytes;
+    }
+
+    std::size_t size() const {
+        return length;
+    }
+};
+
+#endif
@@ -0,0 +1,201 @@
+#pragma once
+
+#ifndef NAME_TABLE_H
+#define NAME_TABLE_H
+
+#include <cstddef>     // Для std::size_t
+#include <functional>  // Для std::hash
+#include <limits>
+#include <stdexcept>   // Для std::length_error
+#include <string>
+#include <string_view>
+#include <utility>     // Для std::move и std::pair
+#include <vector>
+
+// Таблица имен с открытой адресацией и линейным пробированием.
+// Хеши лежат отдельным плотным массивом, поэтому пробирование читает подряд идущие
+// 8-байтовые слова, а строки сравниваются только при совпадении хеша.
+// Поиск принимает std::string_view и не создает строку; каждая операция - один проход пробирования
+template <typename Value>
+class NameTable {
+private:
+    struct Slot {
+        std::string key;
+        Value value;
+    };
+
+    std::vector<std::size_t> hashes; // 0 - пустая ячейка
+    std::vector<Slot> slots;
+    std::size_t count = 0;
+    std::size_t mask = 0;
+
+    static std::size_t hashOf(std::string_view key) {
+        const std::size_t hash = std::hash<std::string_view>()(key);
+        return hash == 0 ? 1 : hash;
+    }
+
+    // Ячейка с ключом или пустая ячейка, в которой цепочка закончилась
+    std::size_t probe(std::string_view key, std::size_t hash) const {
+        std::size_t i = hash & mask;
+        while (hashes[i] != 0 && !(hashes[i] == hash && slots[i].key == key)) {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    // Заполнение не выше 3/4: цепочки линейного пробирования остаются короткими
+    // (емкость - степень двойки не меньше 16, поэтому деление точное и без переполнения)
+    static bool overloaded(std::size_t items, std::size_t capacity) {
+        return items > capacity / 4 * 3;
+    }
+
+    void rehash(std::size_t capacity) {
+        std::vector<std::size_t> oldHashes(capacity, 0);
+        std::vector<Slot> oldSlots(capacity);
+        oldHashes.swap(hashes);
+        oldSlots.swap(slots);
+        mask = capacity - 1;
+
+        for (std::size_t i = 0; i < oldHashes.size(); ++i) {
+            if (oldHashes[i] != 0) {
+                std::size_t j = oldHashes[i] & mask;
+                while (hashes[j] != 0) {
+                    j = (j + 1) & mask;
+                }
+                hashes[j] = oldHashes[i];
+                slots[j] = std::move(oldSlots[i]);
+            }
+        }
+    }
+
+    // Удаление обратным сдвигом: следующие элементы цепочки подтягиваются в дыру,
+    // поэтому надгробия не нужны и поиск не замедляется после удалений
+    void eraseAt(std::size_t hole) {
+        std::size_t j = hole;
+        while (true) {
+            j = (j + 1) & mask;
+            if (hashes[j] == 0) {
+                break;
+            }
+            const std::size_t home = hashes[j] & mask;
+            // Элемент можно сдвинуть, если его исходная ячейка не лежит между дырой и им самим
+            if (((j - home) & mask) >= ((j - hole) & mask)) {
+                hashes[hole] = hashes[j];
+                slots[hole] = std::move(slots[j]);
+                hole = j;
+            }
+        }
+        hashes[hole] = 0;
+        slots[hole] = Slot();
+        --count;
+    }
+
+public:
+    NameTable() = default;
+
+    NameTable(const NameTable&) = delete;
+    NameTable& operator=(const NameTable&) = delete;
+
+    std::size_t size() const {
+        return count;
+    }
+
+    std::size_t capacity() const {
+        return hashes.size();
+    }
+
+    // Место под items элементов без перестроения таблицы
+    void reserve(std::size_t items) {
+        std::size_t capacity = hashes.empty() ? 16 : hashes.size();
+        while (overloaded(items, capacity)) {
+            if (capacity > std::numeric_limits<std::size_t>::max() / 2) {
+                throw std::length_error("Таблица имен не вмещает столько элементов");
+            }
+            capacity *= 2;
+        }
+        if (capacity != hashes.size()) {
+            rehash(capacity);
+        }
+    }
+
+    Value* find(std::string_view key) {
+        if (count == 0) {
+            return nullptr;
+        }
+        const std::size_t i = probe(key, hashOf(key));
+        return hashes[i] != 0 ? &slots[i].value : nullptr;
+    }
+
+    const Value* find(std::string_view key) const {
+        return const_cast<NameTable*>(this)->find(key);
+    }
+
+    // Значение по ключу; новый элемент создается конструктором по умолчанию.
+    // second == true - элемент вставлен. Строка ключа создается только при вставке
+    std::pair<Value*, bool> tryEmplace(std::string_view key) {
+        reserve(count + 1);
+        const std::size_t hash = hashOf(key);
+        const std::size_t i = probe(key, hash);
+        if (hashes[i] != 0) {
+            return {&slots[i].value, false};
+        }
+        hashes[i] = hash;
+        slots[i].key.assign(key.data(), key.size());
+        ++count;
+        return {&slots[i].value, true};
+    }
+
+    // Удаление, если pred(значение) == true; ключ ищется один раз.
+    // pred может изменить значение, например убрать его часть и удалить элемент, если он опустел
+    template <typename Pred>
+    bool eraseIf(std::string_view key, Pred pred) {
+        if (count == 0) {
+            return false;
+        }
+        const std::size_t i = probe(key, hashOf(key));
+        if (hashes[i] == 0 || !pred(slots[i].value)) {
+            return false;
+        }
+        eraseAt(i);
+        return true;
+    }
+
+    bool erase(std::string_view key) {
+        return eraseIf(key, [](const Value&) { return true; });
+    }
+
+    void swap(NameTable& other) {
+        hashes.swap(other.hashes);
+        slots.swap(other.slots);
+        std::swap(count, other.count);
+        std::swap(mask, other.mask);
+    }
+
+    void clear() {
+        hashes.clear();
+        slots.clear();
+        count = 0;
+        mask = 0;
+    }
+
+    // Обход в порядке ячеек: f(std::string_view имя, Value& значение)
+    template <typename F>
+    void forEach(F f) {
+        for (std::size_t i = 0; i < hashes.size(); ++i) {
+            if (hashes[i] != 0) {
+                f(std::string_view(slots[i].key), slots[i].value);
+            }
+        }
+    }
+
+    template <typename F>
+    void forEach(F f) const {
+        for (std::size_t i = 0; i < hashes.size(); ++i) {
+            if (hashes[i] != 0) {
+                f(std::string_view(slots[i].key), slots[i].value);
+            }
+        }
+    }
+};
+
+#endif
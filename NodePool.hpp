@@ -0,0 +1,309 @@
+#pragma once
+
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include "UniquePtr.hpp"
+#include <cstddef>  // Для std::size_t и std::max_align_t
+#include <new>      // Для ::operator new
+#include <type_traits>
+#include <utility>  // Для std::declval
+#include <vector>
+
+// Пул блоков одного размера: память берется большими кусками,
+// освобожденные блоки не возвращаются в кучу, а попадают в список свободных
+class NodePool {
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    std::size_t blockSize;
+    std::size_t blocksPerChunk;
+    std::vector<UniquePtr<unsigned char[]>> chunks;
+    FreeBlock* freeList = nullptr;
+    unsigned char* cursor = nullptr;   // Еще не выданная часть последнего куска
+    unsigned char* chunkEnd = nullptr;
+
+    void addChunk() {
+        chunks.emplace_back(new unsigned char[blockSize * blocksPerChunk]);
+        cursor = chunks.back().get();
+        chunkEnd = cursor + blockSize * blocksPerChunk;
+    }
+
+public:
+    // blockSize должен быть кратен выравниванию хранимых объектов
+    NodePool(std::size_t size, std::size_t perChunk)
+        : blockSize(size < sizeof(FreeBlock) ? sizeof(FreeBlock) : size),
+          blocksPerChunk(perChunk) {}
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    void* allocate() {
+        if (freeList) {
+            FreeBlock* block = freeList;
+            freeList = block->next;
+            return block;
+        }
+        if (cursor == chunkEnd) {
+            addChunk();
+        }
+        void* block = cursor;
+        cursor += blockSize;
+        return block;
+    }
+
+    void deallocate(void* p) {
+        FreeBlock* block = static_cast<FreeBlock*>(p);
+        block->next = freeList;
+        freeList = block;
+    }
+
+    std::size_t getBlockSize() const {
+        return blockSize;
+    }
+
+    // Сколько памяти пул взял у кучи
+    std::size_t reservedBytes() const {
+        return chunks.size() * blockSize * blocksPerChunk;
+    }
+};
+
+// Набор пулов по размерам блоков. Не потокобезопасен:
+// в каждый момент ресурсом пользуется один поток
+class PoolResource {
+private:
+    std::size_t blocksPerChunk;
+    std::vector<UniquePtr<NodePool>> pools; // Обычно один-два размера, поиск линейный
+    NodePool* lastPool = nullptr;           // Последний использованный пул
+
+    static std::size_t blockSizeFor(std::size_t bytes, std::size_t alignment) {
+        if (alignment < alignof(void*)) alignment = alignof(void*);
+        return (bytes + alignment - 1) / alignment * alignment;
+    }
+
+    NodePool& poolFor(std::size_t blockSize) {
+        if (lastPool && lastPool->getBlockSize() == blockSize) {
+            return *lastPool;
+        }
+        for (auto& pool : pools) {
+            if (pool->getBlockSize() == blockSize) {
+                lastPool = pool.get();
+                return *lastPool;
+            }
+        }
+        pools.emplace_back(new NodePool(blockSize, blocksPerChunk));
+        lastPool = pools.back().get();
+        return *lastPool;
+    }
+
+public:
+    explicit PoolResource(std::size_t perChunk = 4096) : blocksPerChunk(perChunk) {}
+
+    PoolResource(const PoolResource&) = delete;
+    PoolResource& operator=(const PoolResource&) = delete;
+
+    void* allocate(std::size_t bytes, std::size_t alignment) {
+        return poolFor(blockSizeFor(bytes, alignment)).allocate();
+    }
+
+    void deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+        poolFor(blockSizeFor(bytes, alignment)).deallocate(p);
+    }
+
+    // Вернуть всю память разом, без обхода выданных блоков. Блоки к этому моменту
+    // не должны использоваться, а их объекты не должны требовать деструктора
+    void release() {
+        pools.clear();
+        lastPool = nullptr;
+    }
+
+    std::size_t reservedBytes() const {
+        std::size_t total = 0;
+        for (const auto& pool : pools) {
+            total += pool->reservedBytes();
+        }
+        return total;
+    }
+};
+
+// Аллокатор в стиле std::allocator поверх PoolResource.
+// Одиночные объекты (узлы) берутся из пула, массивы - из обычной кучи.
+// Ресурс задается явно и должен жить дольше всех контейнеров, которые им пользуются.
+// Ресурса по умолчанию нет: узел, освобожденный в другом потоке (например, списком,
+// отданным BackgroundReclaimer), должен вернуться в тот же пул, из которого взят.
+// Пока список освобождается в другом потоке, этим ресурсом никто другой не пользуется.
+// OwnsResource - ресурсом пользуется только один контейнер: при очистке он не обходит
+// узлы с тривиальными данными, а возвращает всю память ресурса через release()
+template<typename T, bool OwnsResource = false>
+class PoolAllocator {
+private:
+    PoolResource* resource;
+
+    PoolResource& pool() const {
+        return *resource;
+    }
+
+public:
+    template <typename U, bool>
+    friend class PoolAllocator;
+
+    using value_type = T;
+
+    // Параметр OwnsResource - не тип, поэтому std::allocator_traits не переносит его сам
+    template <typename U>
+    struct rebind {
+        using other = PoolAllocator<U, OwnsResource>;
+    };
+
+    static constexpr bool bulkRelease = OwnsResource;
+
+    explicit PoolAllocator(PoolResource& r) noexcept : resource(&r) {}
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U, OwnsResource>& other) noexcept : resource(other.resource) {}
+
+    T* allocate(std::size_t n) {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Пул не поддерживает сверхвыровненные типы");
+        if (n != 1) {
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+        return static_cast<T*>(pool().allocate(sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) {
+        if (n != 1) {
+            ::operator delete(p);
+            return;
+        }
+        pool().deallocate(p, sizeof(T), alignof(T));
+    }
+
+    // Память всех узлов контейнера разом; только при OwnsResource
+    void release() {
+        static_assert(OwnsResource, "Ресурс общий: освобождать его целиком может только владелец");
+        pool().release();
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U, OwnsResource>& other) const {
+        return &pool() == &other.pool();
+    }
+
+    template <typename U>
+    bool operator!=(const PoolAllocator<U, OwnsResource>& other) const {
+        return !(*this == other);
+    }
+};
+
+// Монотонная арена: блоки выдаются подряд, deallocate ничего не делает,
+// вся память возвращается сразу - в release() или в деструкторе
+class ArenaResource {
+private:
+    std::size_t chunkSize;
+    std::size_t reserved = 0;
+    std::vector<UniquePtr<unsigned char[]>> chunks;
+    unsigned char* cursor = nullptr;
+    unsigned char* chunkEnd = nullptr;
+
+public:
+    explicit ArenaResource(std::size_t bytesPerChunk = 1 << 20) : chunkSize(bytesPerChunk) {}
+
+    ArenaResource(const ArenaResource&) = delete;
+    ArenaResource& operator=(const ArenaResource&) = delete;
+
+    void* allocate(std::size_t bytes, std::size_t alignment) {
+        std::size_t offset = reinterpret_cast<std::size_t>(cursor) % alignment;
+        std::size_t padding = offset ? alignment - offset : 0;
+        if (cursor == nullptr || static_cast<std::size_t>(chunkEnd - cursor) < padding + bytes) {
+            std::size_t size = bytes > chunkSize ? bytes : chunkSize;
+            chunks.emplace_back(new unsigned char[size]);
+            cursor = chunks.back().get();
+            chunkEnd = cursor + size;
+            reserved += size;
+            padding = 0;
+        }
+        void* block = cursor + padding;
+        cursor += padding + bytes;
+        return block;
+    }
+
+    void deallocate(void*, std::size_t, std::size_t) {}
+
+    // Вернуть всю память разом. Объекты в арене к этому моменту не должны использоваться
+    void release() {
+        chunks.clear();
+        cursor = nullptr;
+        chunkEnd = nullptr;
+        reserved = 0;
+    }
+
+    std::size_t reservedBytes() const {
+        return reserved;
+    }
+};
+
+// Аллокатор поверх ArenaResource. Контейнеры с таким аллокатором
+// не обходят узлы при очистке: память освобождает владелец арены
+template<typename T>
+class ArenaAllocator {
+private:
+    ArenaResource* resource;
+
+public:
+    template <typename U>
+    friend class ArenaAllocator;
+
+    using value_type = T;
+
+    // Отдельные узлы не освобождаются - только вся арена целиком
+    static constexpr bool bulkRelease = true;
+
+    explicit ArenaAllocator(ArenaResource& r) noexcept : resource(&r) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : resource(other.resource) {}
+
+    T* allocate(std::size_t n) {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Арена не поддерживает сверхвыровненные типы");
+        return static_cast<T*>(resource->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, std::size_t) {}
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const {
+        return resource == other.resource;
+    }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const {
+        return !(*this == other);
+    }
+};
+
+// Освобождает ли аллокатор память только целиком (ArenaAllocator)
+template <typename Alloc, typename = void>
+struct IsBulkReleaseAllocator : std::false_type {};
+
+template <typename Alloc>
+struct IsBulkReleaseAllocator<Alloc, std::void_t<decltype(Alloc::bulkRelease)>>
+    : std::integral_constant<bool, Alloc::bulkRelease> {};
+
+template <typename Alloc, typename = void>
+struct HasReleaseFunction : std::false_type {};
+
+template <typename Alloc>
+struct HasReleaseFunction<Alloc, std::void_t<decltype(std::declval<Alloc&>().release())>> : std::true_type {};
+
+// Контейнер бросил узлы без обхода: аллокатор, владеющий ресурсом (PoolAllocator с OwnsResource),
+// возвращает его память сразу, память арены возвращает ее владелец
+template <typename Alloc>
+void releaseAbandonedNodes(Alloc& alloc) {
+    if constexpr (IsBulkReleaseAllocator<Alloc>::value && HasReleaseFunction<Alloc>::value) {
+        alloc.release();
+    }
+}
+
+#endif
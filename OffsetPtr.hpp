@@ -0,0 +1,104 @@
+#pragma once
+
+#ifndef OFFSET_PTR_H
+#define OFFSET_PTR_H
+
+#include <cstddef>     // Для std::ptrdiff_t и std::nullptr_t
+#include <cstdint>     // Для std::uintptr_t
+#include <type_traits>
+
+// Указатель, не зависящий от адреса отображения: хранится смещение цели от адреса
+// самого указателя. Если указатель и цель лежат в одном блоке памяти (файл, разделяемая память),
+// блок можно отобразить по любому адресу или скопировать целиком - указатель останется верным.
+// Не владеет объектом; временем жизни управляет структура, в которой он лежит.
+// Смещение 0 - nullptr, поэтому обнуленная память содержит пустые указатели,
+// а указатель на самого себя не представим
+template <typename T>
+class OffsetPtr {
+private:
+    std::ptrdiff_t offset;
+
+    std::ptrdiff_t offsetTo(const volatile void* target) const noexcept {
+        if (!target) {
+            return 0;
+        }
+        return static_cast<std::ptrdiff_t>(reinterpret_cast<std::uintptr_t>(target) -
+                                           reinterpret_cast<std::uintptr_t>(this));
+    }
+
+public:
+    using element_type = T;
+
+    OffsetPtr() noexcept : offset(0) {}
+
+    OffsetPtr(std::nullptr_t) noexcept : offset(0) {}
+
+    explicit OffsetPtr(T* p) noexcept : offset(offsetTo(p)) {}
+
+    // Копия указывает на тот же объект: смещение пересчитывается от нового адреса
+    OffsetPtr(const OffsetPtr& other) noexcept : offset(offsetTo(other.get())) {}
+
+    template <typename U, typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+    OffsetPtr(const OffsetPtr<U>& other) noexcept : offset(offsetTo(static_cast<T*>(other.get()))) {}
+
+    OffsetPtr& operator=(const OffsetPtr& other) noexcept {
+        offset = offsetTo(other.get());
+        return *this;
+    }
+
+    OffsetPtr& operator=(T* p) noexcept {
+        offset = offsetTo(p);
+        return *this;
+    }
+
+    OffsetPtr& operator=(std::nullptr_t) noexcept {
+        offset = 0;
+        return *this;
+    }
+
+    T* get() const noexcept {
+        if (offset == 0) {
+            return nullptr;
+        }
+        return reinterpret_cast<T*>(reinterpret_cast<std::uintptr_t>(this) + offset);
+    }
+
+    void reset(T* p = nullptr) noexcept {
+        offset = offsetTo(p);
+    }
+
+    std::add_lvalue_reference_t<T> operator*() const noexcept {
+        return *get();
+    }
+
+    T* operator->() const noexcept {
+        return get();
+    }
+
+    explicit operator bool() const noexcept {
+        return offset != 0;
+    }
+
+    // Смещение в байтах от адреса указателя
+    std::ptrdiff_t rawOffset() const noexcept {
+        return offset;
+    }
+
+    friend bool operator==(const OffsetPtr& a, const OffsetPtr& b) noexcept {
+        return a.get() == b.get();
+    }
+
+    friend bool operator!=(const OffsetPtr& a, const OffsetPtr& b) noexcept {
+        return a.get() != b.get();
+    }
+
+    friend bool operator==(const OffsetPtr& a, std::nullptr_t) noexcept {
+        return !a;
+    }
+
+    friend bool operator!=(const OffsetPtr& a, std::nullptr_t) noexcept {
+        return static_cast<bool>(a);
+    }
+};
+
+#endif
@@ -0,0 +1,73 @@
+#pragma once
+
+#ifndef PARALLEL_JOBS_H
+#define PARALLEL_JOBS_H
+
+#include <algorithm> // Для std::min
+#include <cstddef>   // Для std::size_t
+#include <exception> // Для std::exception_ptr
+#include <thread>
+#include <vector>
+
+namespace SmartPointer {
+    namespace detail {
+
+        // Каждому потоку при параллельной обработке списка - не меньше стольких узлов
+        constexpr std::size_t minParallelRun = std::size_t(1) << 16;
+
+        // На сколько отрезков делить length узлов: не больше threads и не короче minParallelRun
+        inline std::size_t parallelRuns(std::size_t length, unsigned threads) {
+            return std::min<std::size_t>(threads, length / minParallelRun);
+        }
+
+        // Длина отрезка index при делении length на runs почти равных частей
+        inline std::size_t runLength(std::size_t length, std::size_t runs, std::size_t index) {
+            return length / runs + (index < length % runs);
+        }
+
+        inline unsigned hardwareThreads() {
+            const unsigned threads = std::thread::hardware_concurrency();
+            return threads == 0 ? 1 : threads;
+        }
+
+        // Запуск job(i) для i < jobs: последняя задача выполняется в текущем потоке.
+        // Если поток не удалось создать (std::system_error при ограничении числа потоков),
+        // оставшиеся задачи выполняются в текущем потоке, а запущенные потоки дожидаются.
+        // Исключение первой упавшей задачи передается вызывающему после завершения всех
+        template <typename Job>
+        void runJobs(std::size_t jobs, Job job) {
+            std::vector<std::exception_ptr> errors(jobs);
+            auto runJob = [&job, &errors](std::size_t i) {
+                try {
+                    job(i);
+                } catch (...) {
+                    errors[i] = std::current_exception();
+                }
+            };
+
+            std::vector<std::thread> workers;
+            std::size_t started = 0;
+            try {
+                workers.reserve(jobs - 1);
+                for (; started + 1 < jobs; ++started) {
+                    workers.emplace_back(runJob, started);
+                }
+            } catch (...) {
+                // Потоков меньше, чем задач: остальные задачи - здесь, ниже
+            }
+            for (std::size_t i = started; i < jobs; ++i) {
+                runJob(i);
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+            for (auto& error : errors) {
+                if (error) {
+                    std::rethrow_exception(error);
+                }
+            }
+        }
+    }
+}
+
+#endif
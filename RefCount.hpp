@@ -0,0 +1,72 @@
+#ifndef REF_COUNT_H
+#define REF_COUNT_H
+
+#include <atomic>  // Для std::atomic
+
+// Политики счетчика ссылок для SharedPtr
+
+// Обычный счетчик: для указателей, которые не покидают один поток
+struct NonAtomicRefCount {
+    using Counter = int;
+
+    static void increment(Counter& c) noexcept {
+        ++c;
+    }
+
+    static void add(Counter& c, int n) noexcept {
+        c += n;
+    }
+
+    // Возвращает true, если была снята последняя ссылка
+    static bool decrement(Counter& c) noexcept {
+        return --c == 0;
+    }
+
+    // Захват ссылки только у живого объекта (WeakPtr::lock)
+    static bool incrementIfNotZero(Counter& c) noexcept {
+        if (c == 0) return false;
+        ++c;
+        return true;
+    }
+
+    static int load(const Counter& c) noexcept {
+        return c;
+    }
+};
+
+// Атомарный счетчик: копии указателя можно раздавать разным потокам
+struct AtomicRefCount {
+    using Counter = std::atomic<int>;
+
+    // Новая ссылка появляется только из уже существующей, упорядочивание не нужно
+    static void increment(Counter& c) noexcept {
+        c.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void add(Counter& c, int n) noexcept {
+        c.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    // release публикует записи в объект, acquire перед удалением видит записи всех потоков
+    static bool decrement(Counter& c) noexcept {
+        return c.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+    // Захват ссылки только у живого объекта: счетчик не должен подняться с нуля
+    static bool incrementIfNotZero(Counter& c) noexcept {
+        int current = c.load(std::memory_order_relaxed);
+        while (current != 0) {
+            if (c.compare_exchange_weak(current, current + 1, std::memory_order_acquire,
+                                        std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static int load(const Counter& c) noexcept {
+        return c.load(std::memory_order_relaxed);
+    }
+};
+
+#endif
@@ -2,93 +2,251 @@
 #define SHARED_PTR_H
 
 #include <type_traits>  // Для std::enable_if и std::is_arithmetic
+#include <new>          // Для placement new
+#include <utility>      // Для std::forward и std::move
+#include <memory>       // Для std::allocator_traits
+
+#include "RefCount.hpp"
+
+namespace detail {
+
+    // Общий блок управления: сильные и слабые ссылки.
+    // Все сильные ссылки вместе держат одну слабую, поэтому блок живет,
+    // пока есть хотя бы одна ссылка любого вида
+    template<typename RefCount>
+    struct ControlBlockBase {
+        typename RefCount::Counter refCount{1};
+        typename RefCount::Counter weakCount{1};
+
+        virtual ~ControlBlockBase() = default;
+        virtual void destroyObject() noexcept = 0;
+        virtual void destroyBlock() noexcept = 0;
+
+        // Адрес управляемого объекта (AtomicSharedPtr хранит только блок)
+        virtual void* managedObject() noexcept = 0;
+
+        // Снятие сильной ссылки: объект уничтожается сразу, блок - с последней слабой
+        void releaseStrong() noexcept {
+            if (RefCount::decrement(refCount)) {
+                destroyObject();
+                releaseWeak();
+            }
+        }
+
+        void releaseWeak() noexcept {
+            if (RefCount::decrement(weakCount)) {
+                destroyBlock();
+            }
+        }
+    };
+
+    // Блок для объекта, созданного отдельно (SharedPtr(new T))
+    template<typename T, typename RefCount>
+    struct PointerControlBlock : ControlBlockBase<RefCount> {
+        T* object;
+
+        explicit PointerControlBlock(T* p) : object(p) {}
+
+        void destroyObject() noexcept override {
+            delete object;
+        }
+
+        void* managedObject() noexcept override {
+            return object;
+        }
+
+        void destroyBlock() noexcept override {
+            delete this;
+        }
+    };
+
+    // Блок, в котором объект лежит рядом со счетчиком (makeShared) - одно выделение памяти.
+    // Память объекта возвращается вместе с блоком, то есть после последнего WeakPtr
+    template<typename T, typename RefCount>
+    struct InplaceControlBlock : ControlBlockBase<RefCount> {
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        template<typename... Args>
+        explicit InplaceControlBlock(Args&&... args) {
+            ::new (static_cast<void*>(storage)) T(std::forward<Args>(args)...);
+        }
+
+        T* object() noexcept {
+            return reinterpret_cast<T*>(storage);
+        }
+
+        void destroyObject() noexcept override {
+            object()->~T();
+        }
+
+        void* managedObject() noexcept override {
+            return object();
+        }
+
+        void destroyBlock() noexcept override {
+            delete this;
+        }
+    };
+
+    // То же, что InplaceControlBlock, но память блока берется у аллокатора (allocateShared)
+    template<typename T, typename RefCount, typename Alloc>
+    struct AllocatedControlBlock : ControlBlockBase<RefCount> {
+        using BlockAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<AllocatedControlBlock>;
+        using BlockTraits = std::allocator_traits<BlockAlloc>;
+
+        BlockAlloc alloc;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        template<typename... Args>
+        explicit AllocatedControlBlock(const BlockAlloc& a, Args&&... args) : alloc(a) {
+            ::new (static_cast<void*>(storage)) T(std::forward<Args>(args)...);
+        }
+
+        T* object() noexcept {
+            return reinterpret_cast<T*>(storage);
+        }
+
+        void destroyObject() noexcept override {
+            object()->~T();
+        }
+
+        void* managedObject() noexcept override {
+            return object();
+        }
+
+        void destroyBlock() noexcept override {
+            BlockAlloc a(alloc);
+            BlockTraits::destroy(a, this);
+            BlockTraits::deallocate(a, this, 1);
+        }
+    };
+}
+
+template<typename T, typename RefCount>
+class WeakPtr;
 
 template<typename T>
+class AtomicSharedPtr;
+
+// RefCount - политика счетчика: NonAtomicRefCount (по умолчанию) или AtomicRefCount
+template<typename T, typename RefCount = NonAtomicRefCount>
 class SharedPtr {
 private:
+    using ControlBlock = detail::ControlBlockBase<RefCount>;
+
     T* ptr;
-    int* ref_count;
-    
+    ControlBlock* ctrl;
+
     void release() {
-        if (ref_count) { 
-            if (--(*ref_count) == 0) {
-                delete ptr;
-                delete ref_count;
-            }
+        if (ctrl) {
+            ctrl->releaseStrong();
         }
     }
 
-public:
+    // Используется makeShared и WeakPtr::lock: ссылка в блоке уже учтена
+    SharedPtr(T* p, ControlBlock* block) : ptr(p), ctrl(block) {}
+
     template <typename U>
+    static SharedPtr convertedCopy(const SharedPtr<U, RefCount>& other) {
+        if (!other.ptr) {
+            return SharedPtr();
+        }
+        auto* block = new detail::InplaceControlBlock<T, RefCount>(static_cast<T>(*other.ptr));
+        return SharedPtr(block->object(), block);
+    }
+
+public:
+    template <typename U, typename R>
     friend class SharedPtr;
 
-    // Конструктор по умолчанию
-    SharedPtr() : ptr(nullptr), ref_count(new int(1)) {}
+    template <typename U, typename R>
+    friend class WeakPtr;
+
+    template <typename U>
+    friend class AtomicSharedPtr;
+
+    template <typename U, typename R, typename... Args>
+    friend SharedPtr<U, R> makeShared(Args&&... args);
+
+    template <typename U, typename R, typename A, typename... Args>
+    friend SharedPtr<U, R> allocateShared(const A& alloc, Args&&... args);
+
+    // Конструктор по умолчанию (память не выделяется)
+    SharedPtr() : ptr(nullptr), ctrl(nullptr) {}
 
     // Инициализация с указателем на объект
-    explicit SharedPtr(T* p) : ptr(p), ref_count(new int(1)) {}
+    explicit SharedPtr(T* p)
+        : ptr(p), ctrl(p ? new detail::PointerControlBlock<T, RefCount>(p) : nullptr) {}
 
     // Конструктор копирования
     SharedPtr(const SharedPtr& other)
-        : ptr(other.ptr), ref_count(other.ref_count) {
-        if (ref_count) ++(*ref_count);
+        : ptr(other.ptr), ctrl(other.ctrl) {
+        if (ctrl) RefCount::increment(ctrl->refCount);
+    }
+
+    // Конструктор копирования для наследуемых классов: блок управления общий
+    template <typename U, typename std::enable_if<std::is_convertible<U*, T*>::value, int>::type = 0>
+    SharedPtr(const SharedPtr<U, RefCount>& other)
+        : ptr(other.ptr), ctrl(other.ctrl) {
+        if (ctrl) RefCount::increment(ctrl->refCount);
+    }
+
+    // Преобразование числовых типов (SharedPtr<float> f = intPtr): значение копируется
+    // в новый объект со своим счетчиком, одно выделение памяти. Чтобы читать значение
+    // владельца без выделения и копирования, используется viewAs<T>(ptr)
+    template <typename U, typename std::enable_if<!std::is_convertible<U*, T*>::value &&
+                                                  std::is_arithmetic<U>::value &&
+                                                  std::is_arithmetic<T>::value, int>::type = 0>
+    SharedPtr(const SharedPtr<U, RefCount>& other)
+        : SharedPtr(convertedCopy(other)) {}
+
+    // Конструктор совмещения: p указывает внутрь объекта owner (поле, элемент массива)
+    // или на связанный с ним объект; счетчик общий с owner, память не выделяется.
+    // Если owner пуст, результат хранит p, но ничем не владеет
+    template <typename U>
+    SharedPtr(const SharedPtr<U, RefCount>& owner, T* p) noexcept
+        : ptr(p), ctrl(owner.ctrl) {
+        if (ctrl) RefCount::increment(ctrl->refCount);
     }
 
-    // Конструктор копирования для числовых типов и наследуемых классов
+    // То же с переносом ссылки owner: счетчик не меняется
     template <typename U>
-    SharedPtr(const SharedPtr<U>& other,
-              typename std::enable_if<
-                  std::is_convertible<U*, T*>::value ||
-                  (std::is_arithmetic<U>::value && std::is_arithmetic<T>::value), int>::type* = 0)
-        : ptr(nullptr), ref_count(other.ref_count) {
-        if (ref_count) {
-            ++(*ref_count);
-            if constexpr (std::is_arithmetic<U>::value && std::is_arithmetic<T>::value) {
-                ptr = new T(static_cast<T>(*other.get())); // Преобразование значений
-            } else {
-                ptr = static_cast<T*>(other.get());
-            }
-        }
+    SharedPtr(SharedPtr<U, RefCount>&& owner, T* p) noexcept
+        : ptr(p), ctrl(owner.ctrl) {
+        owner.ptr = nullptr;
+        owner.ctrl = nullptr;
     }
 
     // Оператор присваивания
     SharedPtr& operator=(const SharedPtr& other) {
-        if (this != &other) {
+        if (ctrl == other.ctrl) {
+            ptr = other.ptr; // Тот же блок управления - счетчик не меняется
+        } else {
+            // other может жить внутри освобождаемого объекта (head = head->next)
+            T* newPtr = other.ptr;
+            ControlBlock* newCtrl = other.ctrl;
+            if (newCtrl) RefCount::increment(newCtrl->refCount);
             release();
-            ptr = other.ptr;
-            ref_count = other.ref_count;
-            if (ref_count) ++(*ref_count);
+            ptr = newPtr;
+            ctrl = newCtrl;
         }
         return *this;
     }
 
     // Оператор присваивания для числовых типов и наследуемых классов
     template <typename U>
-    SharedPtr<T>& operator=(const SharedPtr<U>& other) {
+    SharedPtr& operator=(const SharedPtr<U, RefCount>& other) {
         static_assert(std::is_convertible<U*, T*>::value ||
                       (std::is_arithmetic<U>::value && std::is_arithmetic<T>::value),
                       "Поддерживаются только числовые типы или связанные типы");
-
-        if (reinterpret_cast<void*>(this) != reinterpret_cast<const void*>(&other)) {
-            release();
-            ref_count = other.ref_count;
-            if (ref_count) {
-                ++(*ref_count);
-                if constexpr (std::is_arithmetic<U>::value && std::is_arithmetic<T>::value) {
-                    ptr = new T(static_cast<T>(*other.get()));
-                } else {
-                    ptr = static_cast<T*>(other.get());
-                }
-            }
-        }
-        return *this;
+        return *this = SharedPtr(other); // Копия берет ссылку до освобождения старого объекта
     }
 
     // Конструктор перемещения
     SharedPtr(SharedPtr&& other) noexcept
-        : ptr(other.ptr), ref_count(other.ref_count) {
+        : ptr(other.ptr), ctrl(other.ctrl) {
         other.ptr = nullptr;
-        other.ref_count = nullptr;
+        other.ctrl = nullptr;
     }
 
     // Оператор присваивания перемещением
@@ -96,16 +254,21 @@ public:
         if (this != &other) {
             release();
             ptr = other.ptr;
-            ref_count = other.ref_count;
+            ctrl = other.ctrl;
             other.ptr = nullptr;
-            other.ref_count = nullptr;
+            other.ctrl = nullptr;
         }
         return *this;
     }
 
     // Получить количество ссылок
     int useCount() const {
-        return ref_count ? *ref_count : 0;
+        return ctrl ? RefCount::load(ctrl->refCount) : 0;
+    }
+
+    // Количество WeakPtr на объект (одну слабую ссылку держат все сильные вместе)
+    int weakCount() const {
+        return ctrl ? RefCount::load(ctrl->weakCount) - 1 : 0;
     }
 
     T* get() const {
@@ -124,7 +287,7 @@ public:
     void reset(T* newPtr = nullptr) {
         release();
         ptr = newPtr;
-        ref_count = new int(1);
+        ctrl = newPtr ? new detail::PointerControlBlock<T, RefCount>(newPtr) : nullptr;
     }
 
     // Приведение к bool для проверки наличия объекта
@@ -138,4 +301,68 @@ public:
     }
 };
 
+// Создание объекта и счетчика одним выделением памяти
+template <typename T, typename RefCount = NonAtomicRefCount, typename... Args>
+SharedPtr<T, RefCount> makeShared(Args&&... args) {
+    auto* block = new detail::InplaceControlBlock<T, RefCount>(std::forward<Args>(args)...);
+    return SharedPtr<T, RefCount>(block->object(), block);
+}
+
+// То же, что makeShared, но блок с объектом выделяется аллокатором (например, PoolAllocator)
+template <typename T, typename RefCount = NonAtomicRefCount, typename Alloc, typename... Args>
+SharedPtr<T, RefCount> allocateShared(const Alloc& alloc, Args&&... args) {
+    using Block = detail::AllocatedControlBlock<T, RefCount, Alloc>;
+    typename Block::BlockAlloc blockAlloc(alloc);
+    Block* block = Block::BlockTraits::allocate(blockAlloc, 1);
+    try {
+        ::new (static_cast<void*>(block)) Block(blockAlloc, std::forward<Args>(args)...);
+    } catch (...) {
+        Block::BlockTraits::deallocate(blockAlloc, block, 1);
+        throw;
+    }
+    return SharedPtr<T, RefCount>(block->object(), block);
+}
+
+// Значение объекта owner, прочитанное как T: хранит ссылку на owner (общий счетчик),
+// а преобразует значение при каждом чтении, поэтому не выделяет память
+// и видит изменения объекта. Возвращает значение, а не ссылку
+template <typename T, typename U, typename RefCount = NonAtomicRefCount>
+class SharedValueView {
+private:
+    static_assert(std::is_arithmetic<T>::value && std::is_arithmetic<U>::value,
+                  "Представление преобразует только числовые типы");
+
+    SharedPtr<U, RefCount> owner;
+
+public:
+    SharedValueView() = default;
+
+    explicit SharedValueView(SharedPtr<U, RefCount> source) noexcept : owner(std::move(source)) {}
+
+    T operator*() const {
+        return static_cast<T>(*owner);
+    }
+
+    explicit operator bool() const {
+        return static_cast<bool>(owner);
+    }
+
+    int useCount() const {
+        return owner.useCount();
+    }
+
+    const SharedPtr<U, RefCount>& source() const {
+        return owner;
+    }
+};
+
+template <typename T, typename U, typename RefCount>
+SharedValueView<T, U, RefCount> viewAs(SharedPtr<U, RefCount> owner) {
+    return SharedValueView<T, U, RefCount>(std::move(owner));
+}
+
+// SharedPtr, копии которого можно передавать между потоками
+template <typename T>
+using ConcurrentSharedPtr = SharedPtr<T, AtomicRefCount>;
+
 #endif
@@ -0,0 +1,254 @@
+#pragma once
+
+#ifndef SHARED_SEGMENT_H
+#define SHARED_SEGMENT_H
+
+#include <cstddef>     // Для std::size_t и std::max_align_t
+#include <cstdint>
+#include <cstring>     // Для std::memcmp и std::memcpy
+#include <new>         // Для std::bad_alloc и placement new
+#include <stdexcept>   // Для std::runtime_error
+#include <string>
+#include <utility>     // Для std::exchange и std::forward
+
+#include "MappedFile.hpp"
+#include "OffsetPtr.hpp"
+#include "UniquePtr.hpp"
+
+#ifdef SMART_POINTER_HAS_MMAP
+#define SMART_POINTER_HAS_SHARED_MAPPING 1
+#endif
+
+// Куча внутри блока памяти, который можно отобразить по другому адресу (файл, /dev/shm).
+// Лежит в начале блока; все ссылки внутри блока - OffsetPtr, поэтому блок, заполненный
+// одним процессом, другой процесс отображает и читает без исправления указателей.
+// Блоки до 256 байт после освобождения попадают в списки свободных по размеру.
+// Не потокобезопасна: в блок пишет один поток одного процесса
+class OffsetHeap {
+private:
+    struct FreeBlock {
+        OffsetPtr<FreeBlock> next;
+    };
+
+    static constexpr std::size_t granularity = 16;
+    static constexpr std::size_t sizeClasses = 16; // Блоки 16, 32, ..., 256 байт
+
+    char magic[8];
+    std::uint32_t byteOrder;
+    std::uint32_t version;
+    std::uint64_t capacity; // Размер всего блока вместе с заголовком
+    std::uint64_t used;     // Смещение первого свободного байта от начала блока
+    OffsetPtr<FreeBlock> freeLists[sizeClasses];
+    OffsetPtr<void> rootObject;
+
+    static constexpr char magicValue[8] = {'O', 'F', 'F', 'H', 'E', 'A', 'P', '\0'};
+    static constexpr std::uint32_t byteOrderMark = 0x01020304;
+    static constexpr std::uint32_t currentVersion = 1;
+
+    OffsetHeap(std::size_t size) : byteOrder(byteOrderMark), version(currentVersion), capacity(size) {
+        std::memcpy(magic, magicValue, sizeof(magic));
+        used = (sizeof(OffsetHeap) + granularity - 1) / granularity * granularity;
+    }
+
+    unsigned char* base() {
+        return reinterpret_cast<unsigned char*>(this);
+    }
+
+    static std::size_t roundUp(std::size_t bytes) {
+        return bytes < granularity ? granularity : (bytes + granularity - 1) / granularity * granularity;
+    }
+
+public:
+    OffsetHeap(const OffsetHeap&) = delete;
+    OffsetHeap& operator=(const OffsetHeap&) = delete;
+
+    // Новая куча в обнуленном блоке region размером size байт
+    static OffsetHeap* create(void* region, std::size_t size) {
+        if (size < sizeof(OffsetHeap) || reinterpret_cast<std::uintptr_t>(region) % alignof(OffsetHeap) != 0) {
+            throw std::invalid_argument("Блок слишком мал или не выровнен для кучи");
+        }
+        return new (region) OffsetHeap(size);
+    }
+
+    // Куча, созданная раньше (возможно, другим процессом и по другому адресу)
+    static OffsetHeap* attach(void* region, std::size_t size) {
+        if (size < sizeof(OffsetHeap)) {
+            throw std::runtime_error("Блок короче заголовка кучи");
+        }
+        OffsetHeap* heap = static_cast<OffsetHeap*>(region);
+        if (std::memcmp(heap->magic, magicValue, sizeof(magicValue)) != 0 || heap->byteOrder != byteOrderMark ||
+            heap->version != currentVersion) {
+            throw std::runtime_error("Блок не содержит кучи этой платформы");
+        }
+        if (heap->capacity > size || heap->used > heap->capacity) {
+            throw std::runtime_error("Куча повреждена или блок отображен не целиком");
+        }
+        return heap;
+    }
+
+    // Память внутри блока; при нехватке места - std::bad_alloc
+    void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+        const std::size_t size = roundUp(bytes);
+        const bool pooled = size <= granularity * sizeClasses && alignment <= granularity;
+        if (pooled) {
+            OffsetPtr<FreeBlock>& list = freeLists[size / granularity - 1];
+            if (FreeBlock* block = list.get()) {
+                list = block->next;
+                return block;
+            }
+        }
+        const std::uint64_t start = (used + alignment - 1) / alignment * alignment;
+        if (start > capacity || capacity - start < size) {
+            throw std::bad_alloc();
+        }
+        used = start + size;
+        return base() + start;
+    }
+
+    void deallocate(void* p, std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+        const std::size_t size = roundUp(bytes);
+        if (!p || size > granularity * sizeClasses || alignment > granularity) {
+            return; // Крупные блоки не переиспользуются
+        }
+        FreeBlock* block = new (p) FreeBlock;
+        OffsetPtr<FreeBlock>& list = freeLists[size / granularity - 1];
+        block->next = list;
+        list = block;
+    }
+
+    template <typename T, typename... Args>
+    T* construct(Args&&... args) {
+        void* memory = allocate(sizeof(T), alignof(T));
+        try {
+            return new (memory) T(std::forward<Args>(args)...);
+        } catch (...) {
+            deallocate(memory, sizeof(T), alignof(T));
+            throw;
+        }
+    }
+
+    template <typename T>
+    void destroy(T* object) {
+        if (object) {
+            object->~T();
+            deallocate(object, sizeof(T), alignof(T));
+        }
+    }
+
+    // Объект, с которого читатель начинает обход блока (например, список)
+    template <typename T>
+    T* root() const {
+        return static_cast<T*>(rootObject.get());
+    }
+
+    void setRoot(void* object) {
+        rootObject = object;
+    }
+
+    bool contains(const void* p) const {
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(p);
+        const std::uintptr_t start = reinterpret_cast<std::uintptr_t>(this);
+        return address >= start && address - start < capacity;
+    }
+
+    std::size_t usedBytes() const {
+        return static_cast<std::size_t>(used);
+    }
+
+    std::size_t capacityBytes() const {
+        return static_cast<std::size_t>(capacity);
+    }
+};
+
+// Блок памяти с OffsetHeap в начале: файл, отображенный MAP_SHARED (файл в /dev/shm -
+// разделяемая память POSIX), или обычная память процесса
+class MappedSegment {
+private:
+    unsigned char* bytes = nullptr;
+    std::size_t length = 0;
+    MappedFile file;                    // Только для create и open
+    AlignedArray<unsigned char> memory; // Только для inMemory и copyOf
+    OffsetHeap* heapPtr = nullptr;
+
+    MappedSegment() = default;
+
+    explicit MappedSegment(MappedFile mapped) : file(std::move(mapped)) {
+        bytes = file.data();
+        length = file.size();
+    }
+
+public:
+    // Новый файл размером size байт с пустой кучей; старое содержимое файла теряется
+    static MappedSegment create(const std::string& path, std::size_t size) {
+        MappedSegment segment(MappedFile::create(path, size));
+        // Новый файл заполнен нулями, в нем создается пустая куча
+        segment.heapPtr = OffsetHeap::create(segment.bytes, segment.length);
+        return segment;
+    }
+
+    // Существующий файл сегмента; изменения видны всем, кто отобразил тот же файл
+    static MappedSegment open(const std::string& path) {
+        MappedSegment segment(MappedFile(path, MappedFile::ReadWrite));
+        segment.heapPtr = OffsetHeap::attach(segment.bytes, segment.length);
+        return segment;
+    }
+
+    // Блок в памяти процесса с пустой кучей
+    static MappedSegment inMemory(std::size_t size) {
+        MappedSegment segment;
+        segment.memory = makeUniqueArray<unsigned char>(size);
+        segment.bytes = segment.memory.get();
+        segment.length = size;
+        segment.heapPtr = OffsetHeap::create(segment.bytes, size);
+        return segment;
+    }
+
+    // Копия содержимого блока source (например, прочитанного из файла) по новому адресу
+    static MappedSegment copyOf(const void* source, std::size_t size) {
+        MappedSegment segment;
+        segment.memory = makeUniqueArrayForOverwrite<unsigned char>(size);
+        std::memcpy(segment.memory.get(), source, size);
+        segment.bytes = segment.memory.get();
+        segment.length = size;
+        segment.heapPtr = OffsetHeap::attach(segment.bytes, size);
+        return segment;
+    }
+
+    MappedSegment(MappedSegment&& other) noexcept
+        : bytes(std::exchange(other.bytes, nullptr)), length(std::exchange(other.length, 0)),
+          file(std::move(other.file)), memory(std::move(other.memory)),
+          heapPtr(std::exchange(other.heapPtr, nullptr)) {}
+
+    MappedSegment& operator=(MappedSegment&& other) noexcept {
+        if (this != &other) {
+            bytes = std::exchange(other.bytes, nullptr);
+            length = std::exchange(other.length, 0);
+            file = std::move(other.file);
+            memory = std::move(other.memory);
+            heapPtr = std::exchange(other.heapPtr, nullptr);
+        }
+        return *this;
+    }
+
+    MappedSegment(const MappedSegment&) = delete;
+    MappedSegment& operator=(const MappedSegment&) = delete;
+
+    OffsetHeap& heap() const {
+        return *heapPtr;
+    }
+
+    const unsigned char* data() const {
+        return bytes;
+    }
+
+    std::size_t size() const {
+        return length;
+    }
+
+    // Записать изменения отображенного файла на диск
+    void flush() {
+        file.flush();
+    }
+};
+
+#endif
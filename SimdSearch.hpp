@@ -0,0 +1,182 @@
+#pragma once
+
+#ifndef SIMD_SEARCH_H
+#define SIMD_SEARCH_H
+
+#include <cstddef>     // Для std::size_t
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h> // SSE2
+#define SMART_POINTER_HAS_SSE2 1
+#endif
+
+// Поиск и подсчет значения в непрерывном массиве.
+// Для числовых типов размером 1, 2, 4 и 8 байт сравнивается 16 байт за инструкцию (SSE2),
+// для остальных типов и без SSE2 используется обычный цикл
+namespace SimdSearch {
+
+    template <typename T>
+    std::size_t scalarFind(const T* data, std::size_t n, const T& value) {
+        for (std::size_t i = 0; i < n; ++i) {
+            if (data[i] == value) {
+                return i;
+            }
+        }
+        return n;
+    }
+
+    template <typename T>
+    std::size_t scalarCount(const T* data, std::size_t n, const T& value) {
+        std::size_t result = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            result += data[i] == value;
+        }
+        return result;
+    }
+
+#ifdef SMART_POINTER_HAS_SSE2
+
+    template <typename T>
+    constexpr bool vectorizable() {
+        return std::is_arithmetic<T>::value && !std::is_same<T, bool>::value &&
+               (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+    }
+
+    namespace detail {
+
+        // Сравнение 16 байт: в совпавших элементах все биты равны единице
+        template <typename T>
+        __m128i matchLanes(const T* data, __m128i needle) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+            if constexpr (std::is_same<T, float>::value) {
+                return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(chunk), _mm_castsi128_ps(needle)));
+            } else if constexpr (std::is_same<T, double>::value) {
+                return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(chunk), _mm_castsi128_pd(needle)));
+            } else if constexpr (sizeof(T) == 1) {
+                return _mm_cmpeq_epi8(chunk, needle);
+            } else if constexpr (sizeof(T) == 2) {
+                return _mm_cmpeq_epi16(chunk, needle);
+            } else if constexpr (sizeof(T) == 4) {
+                return _mm_cmpeq_epi32(chunk, needle);
+            } else {
+                // В SSE2 нет сравнения 64-битных целых: обе половины должны совпасть
+                const __m128i halves = _mm_cmpeq_epi32(chunk, needle);
+                const __m128i swapped = _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1));
+                return _mm_and_si128(halves, swapped);
+            }
+        }
+
+        // Совпавший элемент равен -1, поэтому вычитание увеличивает счетчик в его полосе
+        template <typename T>
+        __m128i addMatches(__m128i counters, __m128i matches) {
+            if constexpr (sizeof(T) == 1) {
+                return _mm_sub_epi8(counters, matches);
+            } else if constexpr (sizeof(T) == 2) {
+                return _mm_sub_epi16(counters, matches);
+            } else if constexpr (sizeof(T) == 4) {
+                return _mm_sub_epi32(counters, matches);
+            } else {
+                return _mm_sub_epi64(counters, matches);
+            }
+        }
+
+        template <typename T>
+        std::size_t sumCounters(__m128i counters) {
+            using Lane = std::conditional_t<sizeof(T) == 1, std::uint8_t,
+                         std::conditional_t<sizeof(T) == 2, std::uint16_t,
+                         std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>>>;
+            alignas(16) Lane lanes[16 / sizeof(T)];
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes), counters);
+            std::size_t total = 0;
+            for (Lane lane : lanes) {
+                total += lane;
+            }
+            return total;
+        }
+
+        template <typename T>
+        __m128i broadcast(const T& value) {
+            alignas(16) T lanes[16 / sizeof(T)];
+            for (auto& lane : lanes) {
+                lane = value;
+            }
+            return _mm_load_si128(reinterpret_cast<const __m128i*>(lanes));
+        }
+
+        inline int lowestBit(int mask) {
+            int index = 0;
+            while (!(mask & 1)) {
+                mask >>= 1;
+                ++index;
+            }
+            return index;
+        }
+    }
+
+    template <typename T>
+    std::size_t find(const T* data, std::size_t n, const T& value) {
+        if constexpr (vectorizable<T>()) {
+            constexpr std::size_t lanes = 16 / sizeof(T);
+            const __m128i needle = detail::broadcast(value);
+            std::size_t i = 0;
+            for (; i + lanes <= n; i += lanes) {
+                const int mask = _mm_movemask_epi8(detail::matchLanes(data + i, needle));
+                if (mask != 0) {
+                    return i + detail::lowestBit(mask) / sizeof(T); // По биту на каждый байт элемента
+                }
+            }
+            return i + scalarFind(data + i, n - i, value);
+        } else {
+            return scalarFind(data, n, value);
+        }
+    }
+
+    template <typename T>
+    std::size_t count(const T* data, std::size_t n, const T& value) {
+        if constexpr (vectorizable<T>()) {
+            constexpr std::size_t lanes = 16 / sizeof(T);
+            // Узкие счетчики сбрасываются в общий итог до переполнения
+            constexpr std::size_t flushEvery = sizeof(T) == 1 ? 255 : sizeof(T) == 2 ? 65535 : SIZE_MAX;
+            const __m128i needle = detail::broadcast(value);
+            __m128i counters = _mm_setzero_si128();
+            std::size_t blocks = 0;
+            std::size_t result = 0;
+            std::size_t i = 0;
+            for (; i + lanes <= n; i += lanes) {
+                counters = detail::addMatches<T>(counters, detail::matchLanes(data + i, needle));
+                if (++blocks == flushEvery) {
+                    result += detail::sumCounters<T>(counters);
+                    counters = _mm_setzero_si128();
+                    blocks = 0;
+                }
+            }
+            result += detail::sumCounters<T>(counters);
+            return result + scalarCount(data + i, n - i, value);
+        } else {
+            return scalarCount(data, n, value);
+        }
+    }
+
+#else
+
+    template <typename T>
+    constexpr bool vectorizable() {
+        return false;
+    }
+
+    template <typename T>
+    std::size_t find(const T* data, std::size_t n, const T& value) {
+        return scalarFind(data, n, value);
+    }
+
+    template <typename T>
+    std::size_t count(const T* data, std::size_t n, const T& value) {
+        return scalarCount(data, n, value);
+    }
+
+#endif
+}
+
+#endif
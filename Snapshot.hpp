@@ -0,0 +1,176 @@
+#pragma once
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstddef>     // Для std::size_t
+#include <cstdint>
+#include <cstring>     // Для std::memcpy
+#include <fstream>
+#include <iterator>    // Для std::begin и std::end
+#include <stdexcept>   // Для std::runtime_error
+#include <string>
+#include <type_traits>
+#include <utility>     // Для std::pair
+
+#include "MappedFile.hpp"
+#include "UniquePtr.hpp"
+
+// Двоичные снимки: заголовок и данные, записанные подряд, читаются обратно через mmap.
+// Формат рассчитан на ту же машину (порядок байтов и размеры типов проверяются при загрузке)
+namespace Snapshot {
+
+    // Виды содержимого снимка
+    enum Kind : std::uint32_t {
+        ArrayKind = 1,    // Массив тривиально копируемых значений (например, элементы списка)
+        RegistryKind = 2  // Реестр именованных указателей (interface.cpp)
+    };
+
+    struct Header {
+        char magic[8];
+        std::uint32_t byteOrder; // 0x01020304 в порядке байтов записавшей машины
+        std::uint32_t kind;
+        std::uint64_t elementSize; // Для ArrayKind - sizeof(T), для реестра - 0
+        std::uint64_t count;
+        std::uint64_t dataOffset;  // Данные выровнены по dataAlignment от начала файла
+        std::uint64_t dataSize;
+    };
+
+    constexpr char magicValue[8] = {'S', 'P', 'S', 'N', 'A', 'P', '1', '\0'};
+    constexpr std::uint32_t byteOrderMark = 0x01020304;
+    constexpr std::size_t dataAlignment = 64;
+    constexpr std::size_t dataOffset = (sizeof(Header) + dataAlignment - 1) / dataAlignment * dataAlignment;
+
+    inline Header makeHeader(Kind kind, std::uint64_t elementSize, std::uint64_t count, std::uint64_t dataSize) {
+        Header header{};
+        std::memcpy(header.magic, magicValue, sizeof(magicValue));
+        header.byteOrder = byteOrderMark;
+        header.kind = kind;
+        header.elementSize = elementSize;
+        header.count = count;
+        header.dataOffset = dataOffset;
+        header.dataSize = dataSize;
+        return header;
+    }
+
+    using ::MappedFile;
+
+    // Снимок только для чтения. Страницы подгружаются при первом обращении;
+    // снимок читается один раз от начала до конца, поэтому ядро читает с опережением
+    inline MappedFile openFile(const std::string& path) {
+        MappedFile file(path, MappedFile::ReadOnly);
+        file.adviseSequential();
+        return file;
+    }
+
+    // Проверенный заголовок снимка вида kind; бросает std::runtime_error, если файл не подходит
+    inline const Header& checkHeader(const MappedFile& file, Kind kind, std::uint64_t elementSize) {
+        if (file.size() < dataOffset) {
+            throw std::runtime_error("Снимок поврежден: файл короче заголовка");
+        }
+        const Header& header = *reinterpret_cast<const Header*>(file.data());
+        if (std::memcmp(header.magic, magicValue, sizeof(magicValue)) != 0 || header.byteOrder != byteOrderMark) {
+            throw std::runtime_error("Файл не является снимком этой платформы");
+        }
+        if (header.kind != kind || header.elementSize != elementSize) {
+            throw std::runtime_error("Снимок содержит данные другого вида");
+        }
+        if (header.dataOffset != dataOffset || header.dataSize > file.size() - dataOffset ||
+            (elementSize != 0 && header.count > header.dataSize / elementSize)) {
+            throw std::runtime_error("Снимок поврежден: данные не помещаются в файл");
+        }
+        return header;
+    }
+
+    // Запись заголовка и данных: writeData(std::ostream&) возвращает {число записей, байт данных}
+    template <typename WriteData>
+    void writeFile(const std::string& path, Kind kind, std::uint64_t elementSize, WriteData writeData) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("Не удалось создать снимок " + path);
+        }
+        const char padding[dataOffset] = {};
+        file.write(padding, dataOffset); // Заголовок пишется в конце, когда известен размер
+        const std::pair<std::uint64_t, std::uint64_t> written = writeData(file);
+        const Header header = makeHeader(kind, elementSize, written.first, written.second);
+        file.seekp(0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        if (!file) {
+            throw std::runtime_error("Ошибка записи снимка " + path);
+        }
+    }
+
+    // Снимок диапазона тривиально копируемых значений, например элементов списка.
+    // Значения копируются в буфер и пишутся крупными блоками
+    template <typename Range>
+    void save(const std::string& path, const Range& range) {
+        using T = std::decay_t<decltype(*std::begin(range))>;
+        static_assert(std::is_trivially_copyable<T>::value, "В снимок пишутся только тривиально копируемые значения");
+        static_assert(alignof(T) <= dataAlignment, "Значения в снимке выровнены по dataAlignment");
+
+        writeFile(path, ArrayKind, sizeof(T), [&range](std::ostream& out) {
+            constexpr std::size_t blockItems = (std::size_t(1) << 16) / sizeof(T) + 1;
+            // Байтовый буфер: T может не иметь конструктора по умолчанию
+            UniquePtr<unsigned char[]> storage(new unsigned char[blockItems * sizeof(T)]);
+            std::size_t filled = 0;
+            std::uint64_t count = 0;
+            for (const auto& value : range) {
+                std::memcpy(storage.get() + filled * sizeof(T), &value, sizeof(T));
+                if (++filled == blockItems) {
+                    out.write(reinterpret_cast<const char*>(storage.get()), static_cast<std::streamsize>(filled * sizeof(T)));
+                    filled = 0;
+                }
+                ++count;
+            }
+            out.write(reinterpret_cast<const char*>(storage.get()), static_cast<std::streamsize>(filled * sizeof(T)));
+            return std::make_pair(count, count * sizeof(T));
+        });
+    }
+
+    // Значения из снимка прямо в отображенных страницах, без копирования.
+    // Пригоден как диапазон для assign и fromRange списков
+    template <typename T>
+    class View {
+    private:
+        static_assert(std::is_trivially_copyable<T>::value, "В снимке хранятся только тривиально копируемые значения");
+
+        MappedFile file;
+        const T* first = nullptr;
+        std::size_t count = 0;
+
+    public:
+        explicit View(const std::string& path) : file(openFile(path)) {
+            const Header& header = checkHeader(file, ArrayKind, sizeof(T));
+            first = reinterpret_cast<const T*>(file.data() + header.dataOffset);
+            count = static_cast<std::size_t>(header.count);
+        }
+
+        const T* begin() const {
+            return first;
+        }
+
+        const T* end() const {
+            return first + count;
+        }
+
+        const T* data() const {
+            return first;
+        }
+
+        std::size_t size() const {
+            return count;
+        }
+    };
+
+    // Замена содержимого списка значениями из снимка за один проход (assign строит узлы
+    // подряд, при std::allocator - в нескольких потоках)
+    template <typename List>
+    std::size_t load(const std::string& path, List& list) {
+        using T = std::decay_t<decltype(*list.begin())>;
+        View<T> view(path);
+        list.assign(view.begin(), view.end());
+        return view.size();
+    }
+}
+
+#endif
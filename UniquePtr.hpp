@@ -2,46 +2,163 @@
 #define UNIQUE_PTR_H
 
 #include <type_traits>  // Для std::enable_if и std::is_base_of
+#include <cstddef>      // Для std::size_t
+#include <utility>      // Для std::move и std::forward
+#include <new>          // Для std::align_val_t и placement new
+#include <limits>       // Для std::numeric_limits
+#include <stdexcept>    // Для std::invalid_argument
 
+// Удалитель по умолчанию
 template<typename T>
-class UniquePtr {
+struct DefaultDelete {
+    DefaultDelete() = default;
+
+    // Удалитель производного типа подходит и для базового
+    template <typename U, typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+    DefaultDelete(const DefaultDelete<U>&) {}
+
+    void operator()(T* p) const {
+        delete p;
+    }
+};
+
+template<typename T>
+struct DefaultDelete<T[]> {
+    void operator()(T* p) const {
+        delete[] p;
+    }
+};
+
+// Удалитель выровненного массива из makeUniqueArray: помнит длину и выравнивание,
+// по ним разрушает элементы и возвращает память. После перемещения длина обнуляется
+template<typename T>
+class AlignedArrayDelete {
+private:
+    std::size_t count;
+    std::size_t alignment;
+
+public:
+    AlignedArrayDelete() : count(0), alignment(alignof(T)) {}
+
+    AlignedArrayDelete(std::size_t n, std::size_t align) : count(n), alignment(align) {}
+
+    AlignedArrayDelete(const AlignedArrayDelete&) = default;
+    AlignedArrayDelete& operator=(const AlignedArrayDelete&) = default;
+
+    AlignedArrayDelete(AlignedArrayDelete&& other) noexcept
+        : count(other.count), alignment(other.alignment) {
+        other.count = 0;
+    }
+
+    AlignedArrayDelete& operator=(AlignedArrayDelete&& other) noexcept {
+        count = other.count;
+        alignment = other.alignment;
+        other.count = 0;
+        return *this;
+    }
+
+    std::size_t size() const {
+        return count;
+    }
+
+    std::size_t align() const {
+        return alignment;
+    }
+
+    void operator()(T* p) const {
+        if constexpr (!std::is_trivially_destructible<T>::value) {
+            for (std::size_t i = count; i > 0; --i) {
+                p[i - 1].~T();
+            }
+        }
+        ::operator delete(static_cast<void*>(p), std::align_val_t(alignment));
+    }
+};
+
+namespace detail {
+
+    // Хранилище удалителя: пустой класс наследуется и не занимает места (EBO),
+    // остальные удалители (с состоянием, указатели на функции) хранятся полем
+    template<typename D, bool = std::is_class<D>::value && std::is_empty<D>::value && !std::is_final<D>::value>
+    class DeleterStorage : private D {
+    public:
+        DeleterStorage() = default;
+
+        template<typename E>
+        explicit DeleterStorage(E&& d) : D(std::forward<E>(d)) {}
+
+        D& deleter() { return *this; }
+        const D& deleter() const { return *this; }
+    };
+
+    template<typename D>
+    class DeleterStorage<D, false> {
+    private:
+        D d;
+
+    public:
+        DeleterStorage() : d() {}
+
+        template<typename E>
+        explicit DeleterStorage(E&& other) : d(std::forward<E>(other)) {}
+
+        D& deleter() { return d; }
+        const D& deleter() const { return d; }
+    };
+}
+
+template<typename T, typename Deleter = DefaultDelete<T>>
+class UniquePtr : private detail::DeleterStorage<Deleter> {
 private:
+    using Storage = detail::DeleterStorage<Deleter>;
+
     T* pointer;
 
 public:
-    UniquePtr() : pointer(nullptr) {}
+    UniquePtr() : Storage(), pointer(nullptr) {}
 
-    explicit UniquePtr(T* p) : pointer(p) {}
+    explicit UniquePtr(T* p) : Storage(), pointer(p) {}
+
+    // Указатель вместе с удалителем (пул, malloc, mmap и т.д.)
+    UniquePtr(T* p, const Deleter& d) : Storage(d), pointer(p) {}
+    UniquePtr(T* p, Deleter&& d) : Storage(std::move(d)), pointer(p) {}
 
     // Запрет копирования
     UniquePtr(const UniquePtr&) = delete;
     UniquePtr& operator = (const UniquePtr&) = delete;
 
     // Конструктор перемещения
-    UniquePtr(UniquePtr&& other) noexcept : pointer(other.pointer) {
-        other.pointer = nullptr;
-    }
+    UniquePtr(UniquePtr&& other) noexcept
+        : Storage(std::move(other.getDeleter())), pointer(other.release()) {}
 
     // Оператор присваивания перемещением
     UniquePtr& operator = (UniquePtr&& other) noexcept {
         if (this != &other) {
-            delete pointer;
-            pointer = other.pointer;
-            other.pointer = nullptr;
+            // other может жить внутри удаляемого объекта (head = std::move(head->next)),
+            // поэтому все забираем из него до reset
+            Deleter d(std::move(other.getDeleter()));
+            reset(other.release());
+            getDeleter() = std::move(d);
         }
         return *this;
     }
 
-    // Конструктор перемещения для наследуемых типов
-    template <typename U, typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
-    UniquePtr(UniquePtr<U>&& other) noexcept : pointer(static_cast<T*>(other.release())) {}
+    // Конструктор перемещения для наследуемых типов (удалитель переносится вместе с объектом)
+    template <typename U, typename E,
+              typename = std::enable_if_t<std::is_convertible<U*, T*>::value &&
+                                          std::is_convertible<E, Deleter>::value>>
+    UniquePtr(UniquePtr<U, E>&& other) noexcept
+        : Storage(std::move(other.getDeleter())), pointer(static_cast<T*>(other.release())) {}
 
     // Оператор присваивания для наследуемых типов
-    template <typename U, typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
-    UniquePtr& operator=(UniquePtr<U>&& other) noexcept {
+    template <typename U, typename E,
+              typename = std::enable_if_t<std::is_convertible<U*, T*>::value &&
+                                          std::is_assignable<Deleter&, E&&>::value>>
+    UniquePtr& operator=(UniquePtr<U, E>&& other) noexcept {
         if (reinterpret_cast<void*>(this) != reinterpret_cast<void*>(&other)) {
-            delete pointer;
-            pointer = static_cast<T*>(other.release());
+            Deleter d(std::move(other.getDeleter()));
+            reset(static_cast<T*>(other.release()));
+            getDeleter() = std::move(d);
         }
         return *this;
     }
@@ -66,6 +183,14 @@ public:
         return pointer;
     }
 
+    Deleter& getDeleter() {
+        return Storage::deleter();
+    }
+
+    const Deleter& getDeleter() const {
+        return Storage::deleter();
+    }
+
     T* release() {
         T* old_ptr = pointer;
         pointer = nullptr;
@@ -73,8 +198,9 @@ public:
     }
 
     void reset(T* new_ptr = nullptr) {
-        delete pointer;
+        T* old_ptr = pointer;
         pointer = new_ptr;
+        if (old_ptr) getDeleter()(old_ptr);
     }
 
     explicit operator bool() const {
@@ -82,36 +208,42 @@ public:
     }
 
     ~UniquePtr() {
-        delete pointer;
+        if (pointer) getDeleter()(pointer);
     }
 };
 
 // Для работы с массивами
-template<typename T>
-class UniquePtr<T[]> {
+template<typename T, typename Deleter>
+class UniquePtr<T[], Deleter> : private detail::DeleterStorage<Deleter> {
 private:
+    using Storage = detail::DeleterStorage<Deleter>;
+
     T* pointer;
 
 public:
-    UniquePtr() : pointer(nullptr) {}
+    UniquePtr() : Storage(), pointer(nullptr) {}
 
-    explicit UniquePtr(T* p) : pointer(p) {}
+    explicit UniquePtr(T* p) : Storage(), pointer(p) {}
+
+    UniquePtr(T* p, const Deleter& d) : Storage(d), pointer(p) {}
+    UniquePtr(T* p, Deleter&& d) : Storage(std::move(d)), pointer(p) {}
 
     // Запрещаем копирование
     UniquePtr(const UniquePtr&) = delete;
     UniquePtr& operator=(const UniquePtr&) = delete;
 
     // Конструктор перемещения
-    UniquePtr(UniquePtr&& other) noexcept : pointer(other.pointer) {
-        other.pointer = nullptr;
-    }
+    UniquePtr(UniquePtr&& other) noexcept
+        : Storage(std::move(other.getDeleter())), pointer(other.release()) {}
 
     // Оператор присваивания перемещением
     UniquePtr& operator=(UniquePtr&& other) noexcept {
         if (this != &other) {
-            delete[] pointer; 
-            pointer = other.pointer;
-            other.pointer = nullptr;
+            // other может жить внутри удаляемого объекта (head = std::move(head->next)),
+            // поэтому все забираем из него до reset
+            Deleter d(std::move(other.getDeleter()));
+            reset(other.release());
+            getDeleter() = std::move(d);
         }
         return *this;
     }
@@ -121,10 +253,43 @@ public:
         return pointer[index];
     }
 
+    const T& operator[](std::size_t index) const {
+        return pointer[index];
+    }
+
+    // Длину знает только удалитель, который ее хранит (AlignedArrayDelete из makeUniqueArray)
+    std::size_t size() const {
+        return pointer ? getDeleter().size() : 0;
+    }
+
+    T* begin() {
+        return pointer;
+    }
+
+    T* end() {
+        return pointer + size();
+    }
+
+    const T* begin() const {
+        return pointer;
+    }
+
+    const T* end() const {
+        return pointer + size();
+    }
+
     T* get() const {
         return pointer;
     }
 
+    Deleter& getDeleter() {
+        return Storage::deleter();
+    }
+
+    const Deleter& getDeleter() const {
+        return Storage::deleter();
+    }
+
     T* release() {
         T* old_ptr = pointer;
         pointer = nullptr;
@@ -132,8 +297,9 @@ public:
     }
 
     void reset(T* new_ptr = nullptr) {
-        delete[] pointer;  
+        T* old_ptr = pointer;
         pointer = new_ptr;
+        if (old_ptr) getDeleter()(old_ptr);
     }
 
     explicit operator bool() const {
@@ -141,8 +307,62 @@ public:
     }
 
     ~UniquePtr() {
-        delete[] pointer;  
+        if (pointer) getDeleter()(pointer);
     }
 };
 
+// Массив, который помнит свою длину и выравнивание
+template<typename T>
+using AlignedArray = UniquePtr<T[], AlignedArrayDelete<T>>;
+
+// Размер строки кэша: выравнивание буферов по умолчанию (подходит и для SSE/AVX)
+constexpr std::size_t cacheLineSize = 64;
+
+namespace detail {
+
+    // Память под n элементов с выравниванием align (степень двойки, не меньше alignof(T))
+    template<typename T>
+    T* allocateAligned(std::size_t n, std::size_t align) {
+        if (align < alignof(T) || (align & (align - 1)) != 0) {
+            throw std::invalid_argument("Выравнивание должно быть степенью двойки не меньше alignof(T)");
+        }
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(align)));
+    }
+
+    // Элементы создаются по очереди; при исключении уже созданные разрушаются
+    template<typename T, bool ValueInit>
+    AlignedArray<T> makeAlignedArray(std::size_t n, std::size_t align) {
+        T* data = allocateAligned<T>(n, align);
+        std::size_t constructed = 0;
+        try {
+            for (; constructed < n; ++constructed) {
+                if constexpr (ValueInit) {
+                    ::new (static_cast<void*>(data + constructed)) T();
+                } else {
+                    ::new (static_cast<void*>(data + constructed)) T; // Тривиальные типы остаются без инициализации
+                }
+            }
+        } catch (...) {
+            AlignedArrayDelete<T>(constructed, align)(data);
+            throw;
+        }
+        return AlignedArray<T>(data, AlignedArrayDelete<T>(n, align));
+    }
+}
+
+// Выровненный массив из n элементов, инициализированных значением по умолчанию (нулями для чисел)
+template<typename T>
+AlignedArray<T> makeUniqueArray(std::size_t n, std::size_t align = cacheLineSize) {
+    return detail::makeAlignedArray<T, true>(n, align);
+}
+
+// То же без инициализации тривиальных типов: для буферов, которые сразу заполняются целиком
+template<typename T>
+AlignedArray<T> makeUniqueArrayForOverwrite(std::size_t n, std::size_t align = cacheLineSize) {
+    return detail::makeAlignedArray<T, false>(n, align);
+}
+
 #endif
@@ -0,0 +1,100 @@
+#ifndef WEAK_PTR_H
+#define WEAK_PTR_H
+
+#include <type_traits>  // Для std::enable_if и std::is_convertible
+
+#include "SharedPtr.hpp"
+
+// Слабая ссылка на объект SharedPtr: не продлевает жизнь объекта,
+// но держит блок управления, чтобы можно было узнать, жив ли объект
+template<typename T, typename RefCount = NonAtomicRefCount>
+class WeakPtr {
+private:
+    using ControlBlock = detail::ControlBlockBase<RefCount>;
+
+    T* ptr;
+    ControlBlock* ctrl;
+
+    void release() {
+        if (ctrl) {
+            ctrl->releaseWeak();
+        }
+    }
+
+public:
+    template <typename U, typename R>
+    friend class WeakPtr;
+
+    WeakPtr() : ptr(nullptr), ctrl(nullptr) {}
+
+    // Слабая ссылка на объект SharedPtr (в том числе производного класса)
+    template <typename U, typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+    WeakPtr(const SharedPtr<U, RefCount>& shared) : ptr(shared.ptr), ctrl(shared.ctrl) {
+        if (ctrl) RefCount::increment(ctrl->weakCount);
+    }
+
+    // Конструктор копирования
+    WeakPtr(const WeakPtr& other) : ptr(other.ptr), ctrl(other.ctrl) {
+        if (ctrl) RefCount::increment(ctrl->weakCount);
+    }
+
+    // Конструктор перемещения
+    WeakPtr(WeakPtr&& other) noexcept : ptr(other.ptr), ctrl(other.ctrl) {
+        other.ptr = nullptr;
+        other.ctrl = nullptr;
+    }
+
+    // Оператор присваивания
+    WeakPtr& operator=(const WeakPtr& other) {
+        if (this != &other) {
+            if (other.ctrl) RefCount::increment(other.ctrl->weakCount);
+            release();
+            ptr = other.ptr;
+            ctrl = other.ctrl;
+        }
+        return *this;
+    }
+
+    // Оператор присваивания перемещением
+    WeakPtr& operator=(WeakPtr&& other) noexcept {
+        if (this != &other) {
+            release();
+            ptr = other.ptr;
+            ctrl = other.ctrl;
+            other.ptr = nullptr;
+            other.ctrl = nullptr;
+        }
+        return *this;
+    }
+
+    // Количество сильных ссылок на объект
+    int useCount() const {
+        return ctrl ? RefCount::load(ctrl->refCount) : 0;
+    }
+
+    // Объект уже уничтожен (или ссылки не было)
+    bool expired() const {
+        return useCount() == 0;
+    }
+
+    // Получить сильную ссылку, если объект еще жив, иначе пустой SharedPtr
+    SharedPtr<T, RefCount> lock() const {
+        if (ctrl && RefCount::incrementIfNotZero(ctrl->refCount)) {
+            return SharedPtr<T, RefCount>(ptr, ctrl);
+        }
+        return SharedPtr<T, RefCount>();
+    }
+
+    // Сбросить ссылку
+    void reset() {
+        release();
+        ptr = nullptr;
+        ctrl = nullptr;
+    }
+
+    ~WeakPtr() {
+        release();
+    }
+};
+
+#endif
@@ -0,0 +1,822 @@
+#include <iostream>
+#include <fstream>   // Запись CSV и JSON
+#include <iomanip>   // Выравнивание вывода
+#include <algorithm> // std::sort
+#include <cerrno>    // ERANGE от std::strtol
+#include <cstdlib>   // std::strtol, system, malloc/free для учета выделений
+#include <cstddef>   // std::max_align_t
+#include <cstdint>   // Поля perf_event_attr
+#include <limits>    // Диапазон int для аргументов
+#include <utility>   // std::pair
+#include <cstring>   // std::strcmp
+#include <thread>    // hardware_concurrency
+#include <atomic>    // Счетчики выделений памяти
+#include <new>       // Замена operator new/delete
+
+#ifdef __linux__
+#include <sched.h>   // sched_setaffinity
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#define NOMINMAX
+#include <windows.h> // SetThreadAffinityMask
+#endif
+
+#include "benchmark.hpp"
+#include "tests.hpp"
+
+// Учет выделений памяти: все формы operator new/delete заменяются счетчиками.
+// Перед блоком хранится его размер, поэтому освобождение учитывается и без sized delete.
+// Атомарные счетчики замедляют выделения, поэтому время сравнивается только со сборкой без учета
+#ifdef BENCHMARK_COUNT_ALLOCATIONS
+
+namespace {
+
+    std::atomic<long long> allocationCount{0};
+    std::atomic<long long> freeCount{0};
+    std::atomic<long long> allocatedBytes{0};
+    std::atomic<long long> liveBytes{0};
+    std::atomic<long long> peakLiveBytes{0};
+
+    constexpr std::size_t defaultHeader = alignof(std::max_align_t);
+
+    std::size_t headerFor(std::size_t align) {
+        return align > defaultHeader ? align : defaultHeader;
+    }
+
+    void* countedAllocate(std::size_t size, std::size_t align) noexcept {
+        const std::size_t header = headerFor(align);
+        void* raw = nullptr;
+        if (align <= defaultHeader) {
+            raw = std::malloc(size + header);
+        } else {
+            raw = std::aligned_alloc(align, (size + header + align - 1) / align * align);
+        }
+        if (!raw) {
+            return nullptr;
+        }
+        unsigned char* block = static_cast<unsigned char*>(raw) + header;
+        reinterpret_cast<std::size_t*>(block)[-1] = size;
+
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        allocatedBytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+        const long long live = liveBytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed) + size;
+        long long peak = peakLiveBytes.load(std::memory_order_relaxed);
+        while (live > peak && !peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+        }
+        return block;
+    }
+
+    void countedFree(void* p, std::size_t align) noexcept {
+        if (!p) {
+            return;
+        }
+        unsigned char* block = static_cast<unsigned char*>(p);
+        const std::size_t size = reinterpret_cast<std::size_t*>(block)[-1];
+        freeCount.fetch_add(1, std::memory_order_relaxed);
+        liveBytes.fetch_sub(static_cast<long long>(size), std::memory_order_relaxed);
+        std::free(block - headerFor(align));
+    }
+
+    void* countedNew(std::size_t size, std::size_t align) {
+        void* p = countedAllocate(size, align);
+        if (!p) {
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+}
+
+void* operator new(std::size_t size) { return countedNew(size, defaultHeader); }
+void* operator new[](std::size_t size) { return countedNew(size, defaultHeader); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return countedAllocate(size, defaultHeader); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return countedAllocate(size, defaultHeader); }
+void* operator new(std::size_t size, std::align_val_t align) { return countedNew(size, static_cast<std::size_t>(align)); }
+void* operator new[](std::size_t size, std::align_val_t align) { return countedNew(size, static_cast<std::size_t>(align)); }
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return countedAllocate(size, static_cast<std::size_t>(align));
+}
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return countedAllocate(size, static_cast<std::size_t>(align));
+}
+
+void operator delete(void* p) noexcept { countedFree(p, defaultHeader); }
+void operator delete[](void* p) noexcept { countedFree(p, defaultHeader); }
+void operator delete(void* p, std::size_t) noexcept { countedFree(p, defaultHeader); }
+void operator delete[](void* p, std::size_t) noexcept { countedFree(p, defaultHeader); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { countedFree(p, defaultHeader); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { countedFree(p, defaultHeader); }
+void operator delete(void* p, std::align_val_t align) noexcept { countedFree(p, static_cast<std::size_t>(align)); }
+void operator delete[](void* p, std::align_val_t align) noexcept { countedFree(p, static_cast<std::size_t>(align)); }
+void operator delete(void* p, std::size_t, std::align_val_t align) noexcept { countedFree(p, static_cast<std::size_t>(align)); }
+void operator delete[](void* p, std::size_t, std::align_val_t align) noexcept { countedFree(p, static_cast<std::size_t>(align)); }
+void operator delete(void* p, std::align_val_t align, const std::nothrow_t&) noexcept {
+    countedFree(p, static_cast<std::size_t>(align));
+}
+void operator delete[](void* p, std::align_val_t align, const std::nothrow_t&) noexcept {
+    countedFree(p, static_cast<std::size_t>(align));
+}
+
+bool allocationCountingEnabled() {
+    return true;
+}
+
+AllocationStats allocationSnapshot() {
+    return {allocationCount.load(), freeCount.load(), allocatedBytes.load(),
+            liveBytes.load(), peakLiveBytes.load()};
+}
+
+void resetAllocationPeak() {
+    peakLiveBytes.store(liveBytes.load());
+}
+
+#else
+
+bool allocationCountingEnabled() {
+    return false;
+}
+
+AllocationStats allocationSnapshot() {
+    return {0, 0, 0, 0, 0};
+}
+
+void resetAllocationPeak() {}
+
+#endif
+
+// Аппаратные счетчики. Каждый счетчик открывается отдельно: в виртуальной машине
+// или при perf_event_paranoid > 2 часть из них (или все) может быть недоступна,
+// такие столбцы остаются пустыми. Считается только поток, вызвавший прогон
+namespace {
+
+    struct PerfCounters {
+        int fds[PerfEventCount] = {-1, -1, -1, -1, -1};
+        double totals[PerfEventCount] = {0, 0, 0, 0, 0};
+        long long regions = 0;
+        bool active = false;
+    };
+
+    PerfCounters perfCounters;
+
+    std::vector<double>* latencySamples = nullptr; // Только во время измеряемых повторов
+    std::vector<void (*)()> scratchReleases;       // Буферы scratchBuffer, освобождаются после набора
+
+#ifdef __linux__
+    int openPerfCounter(std::uint32_t type, std::uint64_t config) {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+#endif
+
+    // true - открыт хотя бы один счетчик
+    bool openPerfCounters() {
+#ifdef __linux__
+        const std::pair<std::uint32_t, std::uint64_t> events[PerfEventCount] = {
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+            {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS}};
+        bool any = false;
+        for (int i = 0; i < PerfEventCount; ++i) {
+            perfCounters.fds[i] = openPerfCounter(events[i].first, events[i].second);
+            any = any || perfCounters.fds[i] >= 0;
+        }
+        perfCounters.active = any;
+        return any;
+#else
+        return false;
+#endif
+    }
+
+    void closePerfCounters() {
+#ifdef __linux__
+        for (int& fd : perfCounters.fds) {
+            if (fd >= 0) {
+                close(fd);
+            }
+            fd = -1;
+        }
+#endif
+        perfCounters.active = false;
+    }
+
+    void resetPerfTotals() {
+        for (double& total : perfCounters.totals) {
+            total = 0;
+        }
+        perfCounters.regions = 0;
+    }
+}
+
+void perfRegionBegin() {
+#ifdef __linux__
+    if (!perfCounters.active) {
+        return;
+    }
+    for (int fd : perfCounters.fds) {
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#endif
+}
+
+void perfRegionEnd() {
+#ifdef __linux__
+    if (!perfCounters.active) {
+        return;
+    }
+    for (int i = 0; i < PerfEventCount; ++i) {
+        const int fd = perfCounters.fds[i];
+        if (fd < 0) {
+            continue;
+        }
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        std::uint64_t values[3] = {0, 0, 0}; // Значение, время включения, время работы
+        if (read(fd, values, sizeof(values)) == static_cast<ssize_t>(sizeof(values)) && values[2] > 0) {
+            // Если счетчиков больше, чем регистров, ядро их чередует: значение масштабируется
+            perfCounters.totals[i] += static_cast<double>(values[0]) * values[1] / values[2];
+        }
+    }
+    ++perfCounters.regions;
+#endif
+}
+
+void recordLatency(double seconds) {
+    if (latencySamples) {
+        latencySamples->push_back(seconds * 1e9);
+    }
+}
+
+void registerScratchRelease(void (*release)()) {
+    scratchReleases.push_back(release);
+}
+
+namespace {
+
+    struct BenchmarkSuite {
+        std::string name;
+        std::string description;
+        std::vector<int> defaultSizes;
+        std::vector<BenchmarkCase> cases;
+        bool latency = false; // Случаи записывают задержки операций: в таблице столбцы p50 и p99
+    };
+
+    std::vector<int> sizeRange(int step, int count) {
+        std::vector<int> sizes;
+        for (int i = 1; i <= count; ++i) {
+            sizes.push_back(i * step);
+        }
+        return sizes;
+    }
+
+    std::vector<BenchmarkSuite> makeSuites() {
+        std::vector<BenchmarkSuite> suites;
+
+        suites.push_back({"pointers", "UniquePtr/SharedPtr против std::unique_ptr/std::shared_ptr",
+                          sizeRange(500'000, 20),
+                          {{"UniquePtr", loadTestUniquePtr},
+                           {"StdUniquePtr", loadTestStdUniquePtr},
+                           {"SharedPtr", loadTestSharedPtr},
+                           {"StdSharedPtr", loadTestStdSharedPtr}}});
+
+        suites.push_back({"conversion", "Преобразования SharedPtr: копия числа против представления и совмещения",
+                          sizeRange(1'000'000, 5),
+                          {{"ConvertCopy", loadTestConvertCopy},
+                           {"ConvertView", loadTestConvertView},
+                           {"Aliasing", loadTestAliasing},
+                           {"StdAliasing", loadTestStdAliasing}}});
+
+        suites.push_back({"cow", "Строки реестра: копирование при записи против новой строки на каждое изменение",
+                          sizeRange(200'000, 5),
+                          {{"StringReplace", loadTestStringReplace},
+                           {"CowWriteShared", loadTestCowWriteShared},
+                           {"CowWriteUnique", loadTestCowWriteUnique},
+                           {"CowCopy", loadTestCowCopy},
+                           {"StringCopy", loadTestStringCopy}}});
+
+        BenchmarkSuite release{"release", "Освобождение списков в вызывающем потоке: сразу против фонового потока "
+                               "(ns/op - среднее время освобождения, p99 - хвост задержки)",
+                               sizeRange(1'000, 5),
+                               {{"Inline", loadTestReleaseInline},
+                                {"Deferred64MiB", [](int n) { return loadTestReleaseDeferred(n, 64); }},
+                                {"Deferred4MiB", [](int n) { return loadTestReleaseDeferred(n, 4); }}}};
+        release.latency = true;
+        suites.push_back(release);
+
+        BenchmarkSuite sharedMT{"shared-mt", "Копирование ConcurrentSharedPtr из нескольких потоков",
+                                {5'000'000}, {}};
+        const int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+        for (int threads = 1; threads <= maxThreads; threads *= 2) {
+            sharedMT.cases.push_back({"SharedPtrMT/" + std::to_string(threads),
+                                      [threads](int N) { return loadTestSharedPtrMT(N, threads); }});
+            sharedMT.cases.push_back({"StdSharedPtrMT/" + std::to_string(threads),
+                                      [threads](int N) { return loadTestStdSharedPtrMT(N, threads); }});
+        }
+        suites.push_back(sharedMT);
+
+        BenchmarkSuite stackMT{"stack-mt", "Общий стек из нескольких потоков: LockFreeStack против списка под мьютексом",
+                               {2'000'000}, {}};
+        for (int threads = 1; threads <= maxThreads; threads *= 2) {
+            stackMT.cases.push_back({"LockFreeStack/" + std::to_string(threads),
+                                     [threads](int N) { return loadTestLockFreeStackMT(N, threads); }});
+            stackMT.cases.push_back({"MutexStack/" + std::to_string(threads),
+                                     [threads](int N) { return loadTestMutexStackMT(N, threads); }});
+        }
+        suites.push_back(stackMT);
+
+        BenchmarkSuite listReaders{"list-readers", "Обходы списка при работающем писателе: EpochReclaim против shared_mutex",
+                                   {20'000}, {}};
+        for (int readers = 1; readers <= maxThreads; readers *= 2) {
+            listReaders.cases.push_back({"EpochReaders/" + std::to_string(readers),
+                                         [readers](int N) { return loadTestListReadersEpoch(N, readers); }});
+            listReaders.cases.push_back({"LockedReaders/" + std::to_string(readers),
+                                         [readers](int N) { return loadTestListReadersLocked(N, readers); }});
+        }
+        suites.push_back(listReaders);
+
+        suites.push_back({"list-pool", "Заполнение и опустошение списков: new против PoolAllocator",
+                          sizeRange(1'000'000, 5),
+                          {{"ListUnique", loadTestListUnique},
+                           {"ListUniquePool", loadTestListUniquePool},
+                           {"ListShared", loadTestListShared},
+                           {"ListSharedPool", loadTestListSharedPool}}});
+
+        suites.push_back({"intrusive", "IntrusivePtr против SharedPtr и std::shared_ptr",
+                          sizeRange(1'000'000, 5),
+                          {{"IntrusivePtr", loadTestIntrusivePtr},
+                           {"IntrusivePtrAtomic", loadTestIntrusivePtrAtomic},
+                           {"SharedPtr", loadTestSharedPtr},
+                           {"StdSharedPtr", loadTestStdSharedPtr}}});
+
+        suites.push_back({"list-find", "Полный обход списков поиском: узел на элемент против развернутого списка",
+                          {1'000'000, 2'000'000, 5'000'000, 10'000'000},
+                          {{"FindUnique", loadTestFindUnique},
+                           {"FindShared", loadTestFindShared},
+                           {"FindUnrolled", loadTestFindUnrolled},
+                           {"FindOffset", loadTestFindOffset}}});
+
+        BenchmarkSuite listSort{"list-sort", "Сортировка списка: перевязка узлов против копирования в вектор и std::forward_list",
+                                {1'000'000, 2'000'000, 5'000'000, 10'000'000}, {}};
+        for (int threads = 1; threads <= maxThreads; threads *= 2) {
+            listSort.cases.push_back({"ListSort/" + std::to_string(threads),
+                                      [threads](int N) { return loadTestListSort(N, threads); }});
+        }
+        listSort.cases.push_back({"ListCopySort", loadTestListCopySort});
+        listSort.cases.push_back({"ForwardListSort", loadTestForwardListSort});
+        suites.push_back(listSort);
+
+        // Размеры - как у набора pointers в runLoadTestsAndPlot
+        BenchmarkSuite listBuild{"list-build", "Сборка списка из диапазона: pushFront против assign и заполнения вектора",
+                                 sizeRange(500'000, 20),
+                                 {{"Vector", loadTestBuildVector},
+                                  {"UniquePushFront", loadTestBuildUniquePushFront},
+                                  {"UniqueAssignPool", loadTestBuildUniqueAssignPool},
+                                  {"UniqueAssignArena", loadTestBuildUniqueAssignArena},
+                                  {"SharedPushFront", loadTestBuildSharedPushFront}}};
+        for (int threads = 1; threads <= maxThreads; threads *= 2) {
+            listBuild.cases.push_back({"UniqueAssign/" + std::to_string(threads),
+                                       [threads](int N) { return loadTestBuildUniqueAssign(N, threads); }});
+            listBuild.cases.push_back({"SharedAssign/" + std::to_string(threads),
+                                       [threads](int N) { return loadTestBuildSharedAssign(N, threads); }});
+        }
+        suites.push_back(listBuild);
+
+        // Страницы снимка перед загрузкой выгружаются из кэша ОС (Linux)
+        suites.push_back({"snapshot-list", "Холодный старт списка: вставка по одному против снимка через mmap",
+                          {1'000'000, 5'000'000, 10'000'000},
+                          {{"ListRebuild", loadTestListRebuild},
+                           {"ListSnapshotLoad", loadTestListSnapshotLoad},
+                           {"ListSnapshotArena", loadTestListSnapshotArena},
+                           {"ListSnapshotView", loadTestListSnapshotView}}});
+
+        suites.push_back({"snapshot-registry", "Холодный старт реестра: повтор сценария команд против снимка",
+                          {250'000, 500'000, 1'000'000},
+                          {{"RegistryRebuild", loadTestRegistryRebuild},
+                           {"RegistrySnapshotLoad", loadTestRegistrySnapshotLoad}}});
+
+        suites.push_back({"simd-scan", "Поиск и подсчет по непрерывной памяти: обычный цикл против SSE2",
+                          {1'000'000, 10'000'000},
+                          {{"FindScalarInt", loadTestFindScalarInt},
+                           {"FindSimdInt", loadTestFindSimdInt},
+                           {"CountScalarInt", loadTestCountScalarInt},
+                           {"CountSimdInt", loadTestCountSimdInt},
+                           {"FindScalarFloat", loadTestFindScalarFloat},
+                           {"FindSimdFloat", loadTestFindSimdFloat},
+                           {"CountUnrolled", loadTestCountUnrolled}}});
+
+        // RegistryOps - время на 3N команд реестра: создание, поиск и удаление каждого имени
+        suites.push_back({"registry", "Поиск имени: NameTable против std::unordered_map и полный путь реестра",
+                          {1'000'000, 2'000'000, 4'000'000},
+                          {{"NameTable", loadTestNameTableLookup},
+                           {"UnorderedMap", loadTestUnorderedMapLookup},
+                           {"RegistryOps", loadTestRegistryOps}}});
+
+        return suites;
+    }
+
+    const BenchmarkSuite* findSuite(const std::vector<BenchmarkSuite>& suites, const std::string& name) {
+        for (const auto& suite : suites) {
+            if (suite.name == name) {
+                return &suite;
+            }
+        }
+        return nullptr;
+    }
+
+    bool pinToCpu(int cpu) {
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return sched_setaffinity(0, sizeof(set), &set) == 0;
+#elif defined(_WIN32)
+        return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu) != 0;
+#else
+        (void)cpu;
+        return false;
+#endif
+    }
+
+    void writeCsv(const std::string& path, const std::string& suite, int repetitions,
+                  const std::vector<BenchmarkResult>& results) {
+        std::ofstream file(path);
+        if (!file.is_open()) {
+            std::cerr << "Ошибка при открытии файла " << path << " для записи!\n";
+            return;
+        }
+        // Столбцы выделений памяти пусты, если программа собрана без их учета
+        file << "Suite,Case,Elements,Repetitions,MinNsPerOp,MedianNsPerOp,P95NsPerOp,MedianMOpsPerSec,"
+                "AllocsPerOp,FreesPerOp,BytesPerOp,PeakLiveBytes,"
+                "CyclesPerOp,InstructionsPerOp,CacheMissesPerOp,BranchMissesPerOp,PageFaultsPerOp,"
+                "P50LatencyNs,P99LatencyNs\n";
+        file << std::fixed << std::setprecision(3);
+        for (const auto& result : results) {
+            file << suite << "," << result.name << "," << result.elements << "," << repetitions << ","
+                 << result.minNs << "," << result.medianNs << "," << result.p95Ns << ","
+                 << 1e3 / result.medianNs << ",";
+            if (allocationCountingEnabled()) {
+                file << result.allocsPerOp << "," << result.freesPerOp << "," << result.bytesPerOp << ","
+                     << result.peakLiveBytes;
+            } else {
+                file << ",,,";
+            }
+            for (double value : result.perfPerOp) {
+                file << ",";
+                if (value >= 0) {
+                    file << value;
+                }
+            }
+            for (double value : {result.p50LatencyNs, result.p99LatencyNs}) {
+                file << ",";
+                if (value >= 0) {
+                    file << value;
+                }
+            }
+            file << "\n";
+        }
+    }
+
+    void writeJson(const std::string& path, const std::string& suite, int repetitions,
+                   const std::vector<BenchmarkResult>& results) {
+        std::ofstream file(path);
+        if (!file.is_open()) {
+            std::cerr << "Ошибка при открытии файла " << path << " для записи!\n";
+            return;
+        }
+        file << std::fixed << std::setprecision(3);
+        file << "{\n  \"suite\": \"" << suite << "\",\n  \"repetitions\": " << repetitions
+             << ",\n  \"results\": [\n";
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const auto& result = results[i];
+            file << "    {\"case\": \"" << result.name << "\", \"elements\": " << result.elements
+                 << ", \"min_ns_per_op\": " << result.minNs
+                 << ", \"median_ns_per_op\": " << result.medianNs
+                 << ", \"p95_ns_per_op\": " << result.p95Ns
+                 << ", \"median_mops_per_sec\": " << 1e3 / result.medianNs;
+            if (allocationCountingEnabled()) {
+                file << ", \"allocs_per_op\": " << result.allocsPerOp
+                     << ", \"frees_per_op\": " << result.freesPerOp
+                     << ", \"bytes_per_op\": " << result.bytesPerOp
+                     << ", \"peak_live_bytes\": " << result.peakLiveBytes;
+            }
+            const char* perfNames[PerfEventCount] = {"cycles_per_op", "instructions_per_op", "cache_misses_per_op",
+                                                     "branch_misses_per_op", "page_faults_per_op"};
+            for (int event = 0; event < PerfEventCount; ++event) {
+                if (result.perfPerOp[event] >= 0) {
+                    file << ", \"" << perfNames[event] << "\": " << result.perfPerOp[event];
+                }
+            }
+            if (result.p99LatencyNs >= 0) {
+                file << ", \"p50_latency_ns\": " << result.p50LatencyNs
+                     << ", \"p99_latency_ns\": " << result.p99LatencyNs;
+            }
+            file << "}" << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+        file << "  ]\n}\n";
+    }
+
+    // Таблица для plot.gp: медианное время прогона в секундах, один столбец на случай
+    void writePlotCsv(const std::string& path, const BenchmarkSuite& suite,
+                      const std::vector<BenchmarkResult>& results) {
+        std::ofstream file(path);
+        if (!file.is_open()) {
+            std::cerr << "Ошибка при открытии файла для записи!\n";
+            return;
+        }
+        file << "Elements";
+        for (const auto& benchmarkCase : suite.cases) {
+            file << "," << benchmarkCase.name;
+        }
+        file << "\n" << std::fixed << std::setprecision(7);
+
+        std::size_t index = 0;
+        while (index < results.size()) {
+            const int elements = results[index].elements;
+            file << elements;
+            for (; index < results.size() && results[index].elements == elements; ++index) {
+                file << "," << results[index].medianNs * elements / 1e9;
+            }
+            file << "\n";
+        }
+    }
+
+    // Неотрицательное int; значения вне диапазона int отвергаются, а не обрезаются
+    bool parseInt(const char* text, int& value) {
+        char* end = nullptr;
+        errno = 0;
+        long parsed = std::strtol(text, &end, 10);
+        if (end == text || *end != '\0' || parsed < 0 || errno == ERANGE ||
+            parsed > std::numeric_limits<int>::max()) {
+            return false;
+        }
+        value = static_cast<int>(parsed);
+        return true;
+    }
+
+    bool parseSizes(const std::string& text, std::vector<int>& sizes) {
+        std::size_t start = 0;
+        while (start <= text.size()) {
+            std::size_t comma = text.find(',', start);
+            std::string item = text.substr(start, comma == std::string::npos ? std::string::npos : comma - start);
+            int size = 0;
+            if (!parseInt(item.c_str(), size) || size == 0) {
+                return false;
+            }
+            sizes.push_back(size);
+            if (comma == std::string::npos) {
+                break;
+            }
+            start = comma + 1;
+        }
+        return !sizes.empty();
+    }
+
+    void printUsage() {
+        std::cout << "Использование: Lab1 --bench [параметры]\n"
+                  << "  --suite NAME      набор тестов (--list - список наборов)\n"
+                  << "  --sizes N1,N2,... число элементов для каждого прогона\n"
+                  << "  --warmup N        прогревочные запуски (по умолчанию 1)\n"
+                  << "  --reps N          измеряемые повторы (по умолчанию 5)\n"
+                  << "  --cpu K           привязать поток к ядру K\n"
+                  << "  --csv PATH        файл CSV (по умолчанию benchmark_results.csv)\n"
+                  << "  --json PATH       файл JSON (по умолчанию benchmark_results.json)\n"
+                  << "  --plot            для набора pointers: load_test_results.csv и график plot.gp\n"
+                  << "  --perf            счетчики perf_event_open (такты, инструкции, промахи кэша и\n"
+                  << "                    переходов, page faults); недоступные счетчики пропускаются\n";
+    }
+}
+
+double percentile(std::vector<double> values, double p) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    std::size_t rank = static_cast<std::size_t>(p * values.size() + 0.999999);
+    if (rank == 0) rank = 1;
+    if (rank > values.size()) rank = values.size();
+    return values[rank - 1];
+}
+
+std::vector<std::string> benchmarkSuites() {
+    std::vector<std::string> names;
+    for (const auto& suite : makeSuites()) {
+        names.push_back(suite.name);
+    }
+    return names;
+}
+
+std::vector<BenchmarkResult> runBenchmarks(const BenchmarkOptions& options) {
+    std::vector<BenchmarkResult> results;
+    const std::vector<BenchmarkSuite> suites = makeSuites();
+    const BenchmarkSuite* suite = findSuite(suites, options.suite);
+    if (!suite) {
+        std::cerr << "Неизвестный набор тестов: " << options.suite << "\n";
+        return results;
+    }
+
+    if (options.cpu >= 0 && !pinToCpu(options.cpu)) {
+        std::cerr << "Не удалось привязать поток к ядру " << options.cpu << ", продолжаем без привязки\n";
+    }
+
+    const bool perf = options.perfCounters && openPerfCounters();
+
+    const std::vector<int>& sizes = options.sizes.empty() ? suite->defaultSizes : options.sizes;
+    const int repetitions = std::max(1, options.repetitions);
+
+    std::cout << suite->description << "\n"
+              << "Прогрев: " << options.warmup << ", повторов: " << repetitions << "\n";
+    std::cout << std::setw(20) << "Case"
+              << std::setw(15) << "Elements"
+              << std::setw(18) << "min (ns/op)"
+              << std::setw(18) << "median (ns/op)"
+              << std::setw(18) << "p95 (ns/op)"
+              << std::setw(18) << "Mops/s";
+    if (allocationCountingEnabled()) {
+        std::cout << std::setw(14) << "allocs/op" << std::setw(14) << "bytes/op";
+    }
+    if (perf) {
+        std::cout << std::setw(14) << "cycles/op" << std::setw(10) << "IPC";
+    }
+    if (suite->latency) {
+        std::cout << std::setw(16) << "p50 lat (ns)" << std::setw(16) << "p99 lat (ns)";
+    }
+    std::cout << std::endl;
+
+    for (int items : sizes) {
+        for (const auto& benchmarkCase : suite->cases) {
+            for (int i = 0; i < options.warmup; ++i) {
+                benchmarkCase.run(items);
+            }
+
+            // Учитываются все выделения за прогон, включая подготовку данных внутри случая
+            resetAllocationPeak();
+            resetPerfTotals();
+            const AllocationStats before = allocationSnapshot();
+            std::vector<double> samples;
+            std::vector<double> latencies;
+            latencySamples = &latencies;
+            for (int i = 0; i < repetitions; ++i) {
+                samples.push_back(benchmarkCase.run(items) * 1e9 / items);
+            }
+            latencySamples = nullptr;
+            const AllocationStats after = allocationSnapshot();
+
+            BenchmarkResult result{benchmarkCase.name, items, percentile(samples, 0.0),
+                                   percentile(samples, 0.5), percentile(samples, 0.95)};
+            const double operations = static_cast<double>(items) * repetitions;
+            result.allocsPerOp = (after.allocations - before.allocations) / operations;
+            result.freesPerOp = (after.frees - before.frees) / operations;
+            result.bytesPerOp = (after.bytes - before.bytes) / operations;
+            result.peakLiveBytes = after.peakLiveBytes - before.liveBytes;
+            // Случаи без perfRegionBegin/End счетчиков не получают
+            if (perf && perfCounters.regions > 0) {
+                for (int event = 0; event < PerfEventCount; ++event) {
+                    if (perfCounters.fds[event] >= 0) {
+                        result.perfPerOp[event] = perfCounters.totals[event] / operations;
+                    }
+                }
+            }
+            if (!latencies.empty()) {
+                result.p50LatencyNs = percentile(latencies, 0.5);
+                result.p99LatencyNs = percentile(latencies, 0.99);
+            }
+            results.push_back(result);
+
+            std::cout << std::setw(20) << result.name
+                      << std::setw(15) << result.elements
+                      << std::fixed << std::setprecision(3)
+                      << std::setw(18) << result.minNs
+                      << std::setw(18) << result.medianNs
+                      << std::setw(18) << result.p95Ns
+                      << std::setw(18) << 1e3 / result.medianNs;
+            if (allocationCountingEnabled()) {
+                std::cout << std::setw(14) << result.allocsPerOp << std::setw(14) << result.bytesPerOp;
+            }
+            if (perf) {
+                const double cycles = result.perfPerOp[PerfCycles];
+                const double instructions = result.perfPerOp[PerfInstructions];
+                if (cycles > 0 && instructions >= 0) {
+                    std::cout << std::setw(14) << cycles << std::setw(10) << instructions / cycles;
+                } else {
+                    std::cout << std::setw(14) << "-" << std::setw(10) << "-"; // Нет аппаратных счетчиков
+                }
+            }
+            if (suite->latency) {
+                std::cout << std::setw(16) << result.p50LatencyNs << std::setw(16) << result.p99LatencyNs;
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    if (perf) {
+        closePerfCounters();
+    }
+    for (auto release : scratchReleases) {
+        release(); // Буферы последнего размера не держат память после набора
+    }
+
+    writeCsv(options.csvPath, suite->name, repetitions, results);
+    writeJson(options.jsonPath, suite->name, repetitions, results);
+    std::cout << "Результаты сохранены в '" << options.csvPath << "' и '" << options.jsonPath << "'\n";
+    return results;
+}
+
+void runBenchmarkSuite(const std::string& suite) {
+    BenchmarkOptions options;
+    options.suite = suite;
+    runBenchmarks(options);
+}
+
+// Набор pointers с сохранением таблицы для plot.gp и построением графика
+static void runAndPlot(const BenchmarkOptions& options) {
+    std::vector<BenchmarkResult> results = runBenchmarks(options);
+    if (results.empty()) {
+        return;
+    }
+
+    const std::vector<BenchmarkSuite> suites = makeSuites();
+    writePlotCsv("load_test_results.csv", *findSuite(suites, options.suite), results);
+    std::cout << "Нагрузочное тестирование окончено, результаты сохранены в 'load_test_results.csv'\n";
+
+    // Запускаем gnuplot
+    int result = system("gnuplot plot.gp");
+    if (result != 0) {
+        std::cerr << "Ошибка при запуске gnuplot, убедитесь, что он установлен и доступен в PATH\n";
+    } else {
+        std::cout << "График построен и сохранен в 'load_test_plot.png'\n";
+    }
+}
+
+void runLoadTestsAndPlot() {
+    runAndPlot(BenchmarkOptions());
+}
+
+int runBenchmarkCommand(int argc, char* argv[]) {
+    BenchmarkOptions options;
+    bool plot = false;
+
+    for (int i = 0; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        bool ok = true;
+
+        if (std::strcmp(arg, "--help") == 0) {
+            printUsage();
+            return 0;
+        } else if (std::strcmp(arg, "--list") == 0) {
+            for (const auto& suite : makeSuites()) {
+                std::cout << std::setw(12) << suite.name << "  " << suite.description << "\n";
+            }
+            return 0;
+        } else if (std::strcmp(arg, "--plot") == 0) {
+            plot = true;
+        } else if (std::strcmp(arg, "--perf") == 0) {
+            options.perfCounters = true;
+        } else if (std::strcmp(arg, "--suite") == 0 && hasValue) {
+            options.suite = argv[++i];
+        } else if (std::strcmp(arg, "--sizes") == 0 && hasValue) {
+            ok = parseSizes(argv[++i], options.sizes);
+        } else if (std::strcmp(arg, "--warmup") == 0 && hasValue) {
+            ok = parseInt(argv[++i], options.warmup);
+        } else if (std::strcmp(arg, "--reps") == 0 && hasValue) {
+            ok = parseInt(argv[++i], options.repetitions);
+        } else if (std::strcmp(arg, "--cpu") == 0 && hasValue) {
+            ok = parseInt(argv[++i], options.cpu);
+        } else if (std::strcmp(arg, "--csv") == 0 && hasValue) {
+            options.csvPath = argv[++i];
+        } else if (std::strcmp(arg, "--json") == 0 && hasValue) {
+            options.jsonPath = argv[++i];
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            std::cerr << "Неверный аргумент: " << arg << "\n";
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (plot) {
+        // Таблица plot.gp рассчитана на столбцы набора pointers
+        if (options.suite != "pointers") {
+            std::cerr << "--plot поддерживается только для набора pointers, а не " << options.suite << "\n";
+            return 1;
+        }
+        runAndPlot(options);
+        return 0;
+    }
+    return runBenchmarks(options).empty() ? 1 : 0;
+}
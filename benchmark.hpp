@@ -0,0 +1,104 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Один измеряемый случай: run(N) выполняет N операций и возвращает время в секундах
+struct BenchmarkCase {
+    std::string name;
+    std::function<double(int)> run;
+};
+
+struct BenchmarkOptions {
+    std::string suite = "pointers";
+    std::vector<int> sizes;        // Пусто - размеры набора по умолчанию
+    int warmup = 1;                // Прогревочные запуски, в статистику не входят
+    int repetitions = 5;
+    int cpu = -1;                  // Ядро для привязки потока, -1 - без привязки
+    std::string csvPath = "benchmark_results.csv";
+    std::string jsonPath = "benchmark_results.json";
+    bool perfCounters = false;     // Аппаратные счетчики perf_event_open (только Linux)
+};
+
+// Счетчики perf_event_open, которые собирает бегун
+enum PerfEvent {
+    PerfCycles,
+    PerfInstructions,
+    PerfCacheMisses,
+    PerfBranchMisses,
+    PerfPageFaults,
+    PerfEventCount
+};
+
+// Статистика по повторам, в наносекундах на операцию.
+// Поля выделений памяти заполняются только в сборке с -DBENCHMARK_COUNT_ALLOCATIONS
+struct BenchmarkResult {
+    std::string name;
+    int elements;
+    double minNs;
+    double medianNs;
+    double p95Ns;
+    double allocsPerOp = 0;
+    double freesPerOp = 0;
+    double bytesPerOp = 0;
+    long long peakLiveBytes = 0;  // Максимум занятой памяти сверх занятой до прогона
+    // Задержки отдельных операций (recordLatency) по всем повторам, нс; < 0 - случай их не записывал
+    double p50LatencyNs = -1;
+    double p99LatencyNs = -1;
+    double perfPerOp[PerfEventCount] = {-1, -1, -1, -1, -1};  // < 0 - счетчик недоступен
+};
+
+// Счетчики глобальных operator new/delete с начала программы
+struct AllocationStats {
+    long long allocations;
+    long long frees;
+    long long bytes;
+    long long liveBytes;
+    long long peakLiveBytes;
+};
+
+// true - программа собрана с -DBENCHMARK_COUNT_ALLOCATIONS и operator new/delete подменены
+bool allocationCountingEnabled();
+AllocationStats allocationSnapshot();
+// Начать отсчет пика занятой памяти с текущего значения
+void resetAllocationPeak();
+
+// Границы измеряемого цикла внутри нагрузочного теста: при --perf между ними
+// работают счетчики perf_event_open, иначе вызовы ничего не делают
+void perfRegionBegin();
+void perfRegionEnd();
+
+// Задержка одной операции в секундах, например освобождения объекта. Бегун собирает
+// их по всем повторам случая и выводит перцентили; при прогреве записи отбрасываются
+void recordLatency(double seconds);
+
+// Освобождение буфера scratchBuffer; бегун вызывает все такие функции после каждого набора
+void registerScratchRelease(void (*release)());
+
+// Буфер из size элементов, общий для прогревочного и измеряемых повторов случая. Новый вектор
+// на каждый повтор получал бы от распределителя то уже отображенные, то свежие страницы;
+// общий выделяется при прогреве, а в повторах resize только обнуляет отображенные страницы.
+// Вызывать до начала замера; после замера буфер очищают (clear), память остается до конца набора
+template <typename T>
+std::vector<T>& scratchBuffer(std::size_t size) {
+    static std::vector<T> buffer;
+    static const bool registered = (registerScratchRelease([] { std::vector<T>().swap(buffer); }), true);
+    (void)registered;
+    buffer.resize(size);
+    return buffer;
+}
+
+// Перцентиль p (0..1) по методу ближайшего ранга
+double percentile(std::vector<double> values, double p);
+
+std::vector<std::string> benchmarkSuites();
+std::vector<BenchmarkResult> runBenchmarks(const BenchmarkOptions& options);
+void runBenchmarkSuite(const std::string& suite);
+
+// Разбор аргументов после --bench, возвращает код завершения программы
+int runBenchmarkCommand(int argc, char* argv[]);
+
+#endif
@@ -1,21 +1,363 @@
 #include <iostream>
-#include <unordered_map>
 #include <string>
 #include <memory>    // Для использования std::unique_ptr и std::shared_ptr 
 #include <limits>  // для std::numeric_limits
+#include <fstream>
+#include <sstream>
+#include <string_view>
+#include <charconv> // std::from_chars для разбора чисел в пакетном режиме
+#include <chrono>
+#include <tuple>
+#include <cstdint>
+#include <cstring>  // std::memcpy для чтения снимка
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
 
 #include "tests.hpp"
+#include "benchmark.hpp"
 #include "interface.hpp"
 #include "UniquePtr.hpp"
 #include "SharedPtr.hpp"
+#include "CowPtr.hpp"
+#include "NameTable.hpp"
+#include "Snapshot.hpp"
+
+// Вид указателя: номер в снимке реестра и бит в PointerEntry::present
+template <typename Ptr>
+struct EntryKind;
+template <>
+struct EntryKind<UniquePtr<int>> : std::integral_constant<std::size_t, 1> {};
+template <>
+struct EntryKind<UniquePtr<std::string>> : std::integral_constant<std::size_t, 2> {};
+template <>
+struct EntryKind<SharedPtr<int>> : std::integral_constant<std::size_t, 3> {};
+template <>
+struct EntryKind<SharedPtr<std::string>> : std::integral_constant<std::size_t, 4> {};
+
+// Указатели одного имени: по ячейке на каждый вид. У каждого вида свои имена:
+// UniquePtr<int> и SharedPtr<int> с одним именем живут рядом и не заменяют друг друга.
+// Ячейка может хранить пустой указатель (источник переноса), поэтому наличие - отдельный бит
+struct PointerEntry {
+    std::tuple<UniquePtr<int>, UniquePtr<std::string>, SharedPtr<int>, SharedPtr<std::string>> ptrs;
+    std::uint8_t present = 0;
+
+    template <typename Ptr>
+    static constexpr std::uint8_t bit() {
+        static_assert(std::is_same<std::tuple_element_t<EntryKind<Ptr>::value - 1, decltype(ptrs)>, Ptr>::value,
+                      "EntryKind должен совпадать с номером ячейки в PointerEntry");
+        return static_cast<std::uint8_t>(1u << (EntryKind<Ptr>::value - 1));
+    }
+
+    template <typename Ptr>
+    bool has() const {
+        return (present & bit<Ptr>()) != 0;
+    }
+
+    template <typename Ptr>
+    Ptr* get() {
+        return has<Ptr>() ? &std::get<Ptr>(ptrs) : nullptr;
+    }
+
+    template <typename Ptr>
+    const Ptr* get() const {
+        return has<Ptr>() ? &std::get<Ptr>(ptrs) : nullptr;
+    }
+
+    // Ячейка вида Ptr, отмеченная как занятая
+    template <typename Ptr>
+    Ptr& set() {
+        present |= bit<Ptr>();
+        return std::get<Ptr>(ptrs);
+    }
+
+    template <typename Ptr>
+    void reset() {
+        present &= static_cast<std::uint8_t>(~bit<Ptr>());
+        std::get<Ptr>(ptrs) = Ptr();
+    }
+
+    bool empty() const {
+        return present == 0;
+    }
+};
+
+// f(указатель) для каждого занятого вида имени, в порядке EntryKind
+template <typename Entry, typename F>
+void forEachPointer(Entry& entry, F f) {
+    std::apply([&entry, &f](auto&... ptrs) {
+        (..., (entry.template has<std::decay_t<decltype(ptrs)>>() ? f(ptrs) : void()));
+    }, entry.ptrs);
+}
+
+// Таблица по имени: одна проба на операцию, поиск по std::string_view без создания строки
+NameTable<PointerEntry> pointers;
+
+// Операции над реестром без ввода-вывода: их используют и меню, и пакетный режим
+
+template <typename Ptr>
+void storeEntry(std::string_view name, Ptr&& value) {
+    pointers.tryEmplace(name).first->set<std::decay_t<Ptr>>() = std::forward<Ptr>(value);
+}
 
-//Для хранения указателей с именами
-std::unordered_map<std::string, UniquePtr<int>> uniquePointersInt;
-std::unordered_map<std::string, UniquePtr<std::string>> uniquePointersString;
+// Перенос указателя под новое имя; источник остается с пустым указателем
+template <typename Ptr>
+bool moveEntry(std::string_view name, std::string_view source) {
+    PointerEntry* entry = pointers.find(source);
+    Ptr* value = entry ? entry->get<Ptr>() : nullptr;
+    if (!value) {
+        return false;
+    }
+    Ptr moved = std::move(*value); // Вставка может перестроить таблицу, поэтому значение забираем заранее
+    storeEntry(name, std::move(moved));
+    return true;
+}
+
+// Копирование SharedPtr под новое имя
+template <typename Ptr>
+bool copyEntry(std::string_view name, std::string_view source) {
+    PointerEntry* entry = pointers.find(source);
+    Ptr* value = entry ? entry->get<Ptr>() : nullptr;
+    if (!value) {
+        return false;
+    }
+    Ptr copy = *value;
+    storeEntry(name, std::move(copy));
+    return true;
+}
+
+// Дописать текст к строке SharedPtr. Строка копируется, только если ее делят другие имена;
+// имена-копии сохраняют старое значение
+bool appendEntry(std::string_view name, std::string_view text) {
+    PointerEntry* entry = pointers.find(name);
+    SharedPtr<std::string>* value = entry ? entry->get<SharedPtr<std::string>>() : nullptr;
+    if (!value || !*value) {
+        return false;
+    }
+    CowPtr<std::string> cow(std::move(*value)); // Ссылка переносится: счетчик считает только другие имена
+    try {
+        cow.write().append(text);
+    } catch (...) {
+        *value = cow.takeShared(); // Копия или дописывание не удались: имя сохраняет прежнюю строку
+        throw;
+    }
+    *value = cow.takeShared();
+    return true;
+}
+
+// Удаление указателя одного из двух типов: 1 - число, 2 - строка, 0 - не найден.
+// Если имя есть у обоих, удаляется число, как в прежних отдельных таблицах.
+// Имя ищется один раз; имя без указателей уходит из таблицы в том же проходе
+template <typename IntPtr, typename StringPtr>
+int eraseEntry(std::string_view name) {
+    int erased = 0;
+    pointers.eraseIf(name, [&erased](PointerEntry& entry) {
+        if (entry.has<IntPtr>()) {
+            entry.reset<IntPtr>();
+            erased = 1;
+        } else if (entry.has<StringPtr>()) {
+            entry.reset<StringPtr>();
+            erased = 2;
+        }
+        return entry.empty();
+    });
+    return erased;
+}
+
+// Снимок реестра. Запись на каждый указатель:
+//   вид (EntryKind, 1 байт), длина имени (4 байта), имя, затем значение:
+//   UniquePtr - признак непустого указателя (1 байт) и значение;
+//   SharedPtr - номер объекта своего типа (4 байта, 0 - пустой указатель); объект с новым номером
+//   записывается сразу за ним, повторные ссылки на него - только номером.
+// Число - 4 байта, строка - длина (4 байта) и байты
+
+class SnapshotWriter {
+private:
+    std::string bytes;
+    // Объект -> номер в снимке; числа и строки нумеруются отдельно
+    std::unordered_map<const void*, std::uint32_t> sharedIds[2];
+
+public:
+    template <typename T>
+    void put(T value) {
+        bytes.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void putString(std::string_view text) {
+        put(static_cast<std::uint32_t>(text.size()));
+        bytes.append(text.data(), text.size());
+    }
+
+    void putValue(int value) {
+        put(static_cast<std::int32_t>(value));
+    }
+
+    void putValue(const std::string& value) {
+        putString(value);
+    }
+
+    template <typename T>
+    void putEntry(const UniquePtr<T>& ptr) {
+        put(static_cast<std::uint8_t>(ptr.get() != nullptr));
+        if (ptr.get()) {
+            putValue(*ptr);
+        }
+    }
+
+    template <typename T>
+    void putEntry(const SharedPtr<T>& ptr) {
+        if (!ptr) {
+            put(std::uint32_t(0));
+            return;
+        }
+        auto& ids = sharedIds[std::is_same<T, std::string>::value];
+        auto [id, inserted] = ids.try_emplace(ptr.get(), static_cast<std::uint32_t>(ids.size() + 1));
+        put(id->second);
+        if (inserted) {
+            putValue(*ptr);
+        }
+    }
+
+    const std::string& data() const {
+        return bytes;
+    }
+};
+
+// Разбор снимка прямо из отображенных страниц; выход за границы данных - std::runtime_error
+class SnapshotReader {
+private:
+    const unsigned char* cursor;
+    const unsigned char* end;
+    std::vector<SharedPtr<int>> sharedInts;            // По номеру объекта в снимке
+    std::vector<SharedPtr<std::string>> sharedStrings;
+
+    void need(std::size_t bytes) const {
+        if (static_cast<std::size_t>(end - cursor) < bytes) {
+            throw std::runtime_error("Снимок реестра поврежден: запись обрывается");
+        }
+    }
+
+    template <typename T>
+    std::vector<SharedPtr<T>>& shared();
+
+public:
+    SnapshotReader(const unsigned char* data, std::size_t size) : cursor(data), end(data + size) {}
+
+    template <typename T>
+    T get() {
+        need(sizeof(T));
+        T value;
+        std::memcpy(&value, cursor, sizeof(T));
+        cursor += sizeof(T);
+        return value;
+    }
+
+    std::string_view getString() {
+        const std::uint32_t size = get<std::uint32_t>();
+        need(size);
+        std::string_view text(reinterpret_cast<const char*>(cursor), size);
+        cursor += size;
+        return text;
+    }
+
+    template <typename T>
+    T getValue() {
+        if constexpr (std::is_same<T, int>::value) {
+            return static_cast<int>(get<std::int32_t>());
+        } else {
+            return T(getString());
+        }
+    }
+
+    template <typename T>
+    UniquePtr<T> getUnique();
+
+    template <typename T>
+    SharedPtr<T> getShared();
+};
+
+template <>
+std::vector<SharedPtr<int>>& SnapshotReader::shared<int>() {
+    return sharedInts;
+}
+
+template <>
+std::vector<SharedPtr<std::string>>& SnapshotReader::shared<std::string>() {
+    return sharedStrings;
+}
+
+template <typename T>
+UniquePtr<T> SnapshotReader::getUnique() {
+    if (get<std::uint8_t>() == 0) {
+        return UniquePtr<T>();
+    }
+    return UniquePtr<T>(new T(getValue<T>()));
+}
+
+template <typename T>
+SharedPtr<T> SnapshotReader::getShared() {
+    const std::uint32_t id = get<std::uint32_t>();
+    if (id == 0) {
+        return SharedPtr<T>();
+    }
+    std::vector<SharedPtr<T>>& objects = shared<T>();
+    if (id == objects.size() + 1) {
+        objects.push_back(makeShared<T>(getValue<T>())); // Первая ссылка: объект записан здесь
+    } else if (id > objects.size()) {
+        throw std::runtime_error("Снимок реестра поврежден: ссылка на незаписанный объект");
+    }
+    return objects[id - 1];
+}
+
+void saveRegistry(const std::string& path) {
+    SnapshotWriter writer;
+    std::uint64_t count = 0;
+    pointers.forEach([&writer, &count](std::string_view name, const PointerEntry& entry) {
+        forEachPointer(entry, [&writer, &count, name](const auto& ptr) {
+            writer.put(static_cast<std::uint8_t>(EntryKind<std::decay_t<decltype(ptr)>>::value));
+            writer.putString(name);
+            writer.putEntry(ptr);
+            ++count;
+        });
+    });
+    Snapshot::writeFile(path, Snapshot::RegistryKind, 0, [&writer, count](std::ostream& out) {
+        out.write(writer.data().data(), static_cast<std::streamsize>(writer.data().size()));
+        return std::make_pair(count, static_cast<std::uint64_t>(writer.data().size()));
+    });
+}
+
+std::size_t loadRegistry(const std::string& path) {
+    const Snapshot::MappedFile file = Snapshot::openFile(path);
+    const Snapshot::Header& header = Snapshot::checkHeader(file, Snapshot::RegistryKind, 0);
+    SnapshotReader reader(file.data() + header.dataOffset, static_cast<std::size_t>(header.dataSize));
+
+    // Самая короткая запись - вид (1 байт) и длина пустого имени (4 байта). Число записей
+    // проверяется до резервирования таблицы: поврежденный заголовок не должен занять всю память
+    if (header.count > header.dataSize / 5) {
+        throw std::runtime_error("Снимок реестра поврежден: записей больше, чем помещается в данных");
+    }
 
-std::unordered_map<std::string, SharedPtr<int>> sharedPointersInt;
-std::unordered_map<std::string, SharedPtr<std::string>> sharedPointersString;
+    // Новый реестр собирается отдельно и подменяет старый, только если снимок прочитан целиком
+    NameTable<PointerEntry> loaded;
+    loaded.reserve(static_cast<std::size_t>(header.count));
+    for (std::uint64_t i = 0; i < header.count; ++i) {
+        const std::uint8_t kind = reader.get<std::uint8_t>();
+        PointerEntry& entry = *loaded.tryEmplace(reader.getString()).first;
+        switch (kind) {
+            case 1: entry.set<UniquePtr<int>>() = reader.getUnique<int>(); break;
+            case 2: entry.set<UniquePtr<std::string>>() = reader.getUnique<std::string>(); break;
+            case 3: entry.set<SharedPtr<int>>() = reader.getShared<int>(); break;
+            case 4: entry.set<SharedPtr<std::string>>() = reader.getShared<std::string>(); break;
+            default: throw std::runtime_error("Снимок реестра поврежден: неизвестный вид указателя");
+        }
+    }
+    pointers.swap(loaded);
+    return pointers.size();
+}
 
+void clearRegistry() {
+    pointers.clear();
+}
 
 template<typename T>
 T getInput() {
@@ -48,15 +390,15 @@ void createUniquePtr() {
     if (choice == 1) {
         std::cout << "Введите значение для UniquePtr: ";
         int value = getInput<int>();
-        uniquePointersInt[name] = UniquePtr<int>(new int(value));
+        storeEntry(name, UniquePtr<int>(new int(value)));
         std::cout << "UniquePtr с именем " << name << " для числа создан\n";
     } else if (choice == 2) {
         std::string strValue;
         std::cout << "Введите строку для UniquePtr: ";
         std::getline(std::cin, strValue);
-        uniquePointersString[name] = UniquePtr<std::string>(new std::string(strValue));
+        storeEntry(name, UniquePtr<std::string>(new std::string(strValue)));
         std::cout << "UniquePtr с именем " << name << " для строки создан\n";
-        std::cout << "Создан UniquePtr для строки: " << *uniquePointersString[name] << "\n";
+        std::cout << "Создан UniquePtr для строки: " << strValue << "\n";
     } else if (choice == 3) {
         std::cout << "Выберите тип существующего UniquePtr (1 - число, 2 - строка): ";
         int subChoice = getInput<int>();
@@ -66,8 +408,7 @@ void createUniquePtr() {
             std::string existingName;
             std::cin >> existingName;
 
-            if (uniquePointersInt.find(existingName) != uniquePointersInt.end()) {
-                uniquePointersInt[name] = std::move(uniquePointersInt[existingName]);
+            if (moveEntry<UniquePtr<int>>(name, existingName)) {
                 std::cout << "UniquePtr с именем " << name << " создан на основе " << existingName << ".\n";
             } else {
                 std::cout << "UniquePtr с таким именем не найден!\n";
@@ -77,8 +418,7 @@ void createUniquePtr() {
             std::string existingName;
             std::cin >> existingName;
 
-            if (uniquePointersString.find(existingName) != uniquePointersString.end()) {
-                uniquePointersString[name] = std::move(uniquePointersString[existingName]);
+            if (moveEntry<UniquePtr<std::string>>(name, existingName)) {
                 std::cout << "UniquePtr с именем " << name << " создан на основе " << existingName << ".\n";
             } else {
                 std::cout << "UniquePtr с таким именем не найден!\n";
@@ -102,13 +442,13 @@ void createSharedPtr() {
     if (choice == 1) {
         std::cout << "Введите значение для SharedPtr: ";
         int value = getInput<int>();
-        sharedPointersInt[name] = SharedPtr<int>(new int(value));
+        storeEntry(name, SharedPtr<int>(new int(value)));
         std::cout << "SharedPtr с именем " << name << " для числа создан\n";
     } else if (choice == 2) {
         std::string strValue;
         std::cout << "Введите строку для SharedPtr: ";
         std::getline(std::cin, strValue);
-        sharedPointersString[name] = SharedPtr<std::string>(new std::string(strValue));
+        storeEntry(name, SharedPtr<std::string>(new std::string(strValue)));
         std::cout << "SharedPtr с именем " << name << " для строки создан\n";
     } else if (choice == 3) {
         std::cout << "Выберите тип существующего SharedPtr (1 - число, 2 - строка): ";
@@ -119,8 +459,7 @@ void createSharedPtr() {
             std::string existingName;
             std::cin >> existingName;
 
-            if (sharedPointersInt.find(existingName) != sharedPointersInt.end()) {
-                sharedPointersInt[name] = sharedPointersInt[existingName];
+            if (copyEntry<SharedPtr<int>>(name, existingName)) {
                 std::cout << "SharedPtr с именем " << name << " создан на основе " << existingName << ".\n";
             } else {
                 std::cout << "SharedPtr с таким именем не найден!\n";
@@ -130,8 +469,7 @@ void createSharedPtr() {
             std::string existingName;
             std::cin >> existingName;
 
-            if (sharedPointersString.find(existingName) != sharedPointersString.end()) {
-                sharedPointersString[name] = sharedPointersString[existingName];
+            if (copyEntry<SharedPtr<std::string>>(name, existingName)) {
                 std::cout << "SharedPtr с именем " << name << " создан на основе " << existingName << ".\n";
             } else {
                 std::cout << "SharedPtr с таким именем не найден!\n";
@@ -150,15 +488,15 @@ void deleteUniquePtr() {
     std::cout << "Введите имя UniquePtr для удаления: ";
     std::cin >> name;
 
-    // Удаление числового указателя
-    if (uniquePointersInt.erase(name)) {
-        std::cout << "UniquePtr для числа с именем " << name << " удален\n";
-    } 
-    // Удаление строкового указателя
-    else if (uniquePointersString.erase(name)) {
-        std::cout << "UniquePtr для строки с именем " << name << " удален\n";
-    } else {
-        std::cout << "UniquePtr с именем " << name << " не найден!\n";
+    switch (eraseEntry<UniquePtr<int>, UniquePtr<std::string>>(name)) {
+        case 1:
+            std::cout << "UniquePtr для числа с именем " << name << " удален\n";
+            break;
+        case 2:
+            std::cout << "UniquePtr для строки с именем " << name << " удален\n";
+            break;
+        default:
+            std::cout << "UniquePtr с именем " << name << " не найден!\n";
     }
 }
 
@@ -168,55 +506,51 @@ void deleteSharedPtr() {
     std::cout << "Введите имя SharedPtr для удаления: ";
     std::cin >> name;
 
-    // Удаление числового указателя
-    if (sharedPointersInt.erase(name)) {
-        std::cout << "SharedPtr для числа с именем " << name << " удален\n";
-    } 
-    // Удаление строкового указателя
-    else if (sharedPointersString.erase(name)) {
-        std::cout << "SharedPtr для строки с именем " << name << " удален\n";
-    } else {
-        std::cout << "SharedPtr с именем " << name << " не найден!\n";
+    switch (eraseEntry<SharedPtr<int>, SharedPtr<std::string>>(name)) {
+        case 1:
+            std::cout << "SharedPtr для числа с именем " << name << " удален\n";
+            break;
+        case 2:
+            std::cout << "SharedPtr для строки с именем " << name << " удален\n";
+            break;
+        default:
+            std::cout << "SharedPtr с именем " << name << " не найден!\n";
     }
 }
 
-// Отображение всех созданных указателей
-void displayPointers() {
-    std::cout << "\nСписок UniquePtr для чисел:\n";
-    for (const auto& [name, ptr] : uniquePointersInt) {
-        if (ptr) {
-            std::cout << "Имя: " << name << ", Значение: " << *ptr << "\n";
-        } else {
-            std::cout << "Имя: " << name << ", Указатель освобожден\n";
-        }
-    }
+template <typename T>
+void displayUseCount(std::ostream&, const UniquePtr<T>&) {}
 
-    std::cout << "\nСписок UniquePtr для строк:\n";
-    for (const auto& [name, ptr] : uniquePointersString) {
-        if (ptr) {
-            std::cout << "Имя: " << name << ", Значение: " << *ptr << "\n";
-        } else {
-            std::cout << "Имя: " << name << ", Указатель освобожден\n";
-        }
-    }
+template <typename T>
+void displayUseCount(std::ostream& out, const SharedPtr<T>& ptr) {
+    out << ", Счетчик ссылок: " << ptr.useCount();
+}
 
-    std::cout << "\nСписок SharedPtr для чисел:\n";
-    for (const auto& [name, ptr] : sharedPointersInt) {
-        if (ptr) {
-            std::cout << "Имя: " << name << ", Значение: " << *ptr << ", Счетчик ссылок: " << ptr.useCount() << "\n";
-        } else {
-            std::cout << "Имя: " << name << ", Указатель освобожден\n";
+// Отображение указателей одного вида
+template <typename Ptr>
+void displaySection(std::ostream& out, const char* title) {
+    out << "\n" << title << ":\n";
+    pointers.forEach([&out](std::string_view name, const PointerEntry& entry) {
+        const Ptr* ptr = entry.get<Ptr>();
+        if (!ptr) {
+            return;
         }
-    }
-
-    std::cout << "\nСписок SharedPtr для строк:\n";
-    for (const auto& [name, ptr] : sharedPointersString) {
-        if (ptr) {
-            std::cout << "Имя: " << name << ", Значение: " << *ptr << ", Счетчик ссылок: " << ptr.useCount() << "\n";
+        if (*ptr) {
+            out << "Имя: " << name << ", Значение: " << **ptr;
+            displayUseCount(out, *ptr);
+            out << "\n";
         } else {
-            std::cout << "Имя: " << name << ", Указатель освобожден\n";
+            out << "Имя: " << name << ", Указатель освобожден\n";
         }
-    }
+    });
+}
+
+// Отображение всех созданных указателей
+void displayPointers(std::ostream& out = std::cout) {
+    displaySection<UniquePtr<int>>(out, "Список UniquePtr для чисел");
+    displaySection<UniquePtr<std::string>>(out, "Список UniquePtr для строк");
+    displaySection<SharedPtr<int>>(out, "Список SharedPtr для чисел");
+    displaySection<SharedPtr<std::string>>(out, "Список SharedPtr для строк");
 }
 
 void testSubtypingConsole() {
@@ -236,6 +570,9 @@ void testSubtypingConsole() {
         std::cout << "SharedPtr<int> успешно присвоен SharedPtr<float>.\n";
         std::cout << "Значение floatPtr: " << *floatPtr << "\n";
         std::cout << "Счетчик ссылок floatPtr: " << floatPtr.useCount() << "\n";
+        SharedValueView<float, int> floatView = viewAs<float>(intPtr); // Без копии: общий счетчик с intPtr
+        std::cout << "Значение через viewAs<float>: " << *floatView
+                  << ", счетчик ссылок: " << floatView.useCount() << "\n";
     } 
     else if (choice == 2) {
         std::cout << "Введите значение для SharedPtr<float>: ";
@@ -289,6 +626,8 @@ void displayMenu() {
                 std::cout << "Выберите Тесты\n";
                 std::cout << "1. Функциональное тестирование\n";
                 std::cout << "2. Нагрузочное тестирование\n";
+                std::cout << "3. Многопоточное нагрузочное тестирование SharedPtr\n";
+                std::cout << "4. Пул узлов для списков\n";
                 std::cout << "0. Выход\n";
                 std::cout << "Ваш выбор:\n";
                 valueForTest = getInput<int>();
@@ -300,6 +639,12 @@ void displayMenu() {
                     case 2:
                         runLoadTestsAndPlot();
                         break;
+                    case 3:
+                        runBenchmarkSuite("shared-mt");
+                        break;
+                    case 4:
+                        runBenchmarkSuite("list-pool");
+                        break;
                     case 0:
                         break;
                     default:
@@ -316,4 +661,216 @@ void displayMenu() {
                 std::cout << "Неверный выбор. Попробуйте снова.\n";
         }
     } while (choice != 0);
-}
\ No newline at end of file
+}
+
+// Пакетный режим: команды читаются из потока целиком и выполняются без подсказок.
+//   create unique|shared int|string ИМЯ ЗНАЧЕНИЕ   (строка - до конца строки)
+//   copy shared int|string ИМЯ ИСТОЧНИК
+//   move unique|shared int|string ИМЯ ИСТОЧНИК
+//   delete unique|shared ИМЯ
+//   append ИМЯ ТЕКСТ   (дописать к строке SharedPtr; копии под другими именами не меняются)
+//   list
+//   save ФАЙЛ   (снимок реестра)
+//   load ФАЙЛ   (реестр заменяется снимком)
+// Пустые строки и строки, начинающиеся с '#', пропускаются
+
+std::string_view nextToken(std::string_view& line) {
+    std::size_t start = line.find_first_not_of(" \t\r");
+    if (start == std::string_view::npos) {
+        line = std::string_view();
+        return line;
+    }
+    std::size_t end = line.find_first_of(" \t\r", start);
+    std::string_view token = line.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start);
+    line = end == std::string_view::npos ? std::string_view() : line.substr(end);
+    return token;
+}
+
+std::string_view restOfLine(std::string_view line) {
+    std::size_t start = line.find_first_not_of(" \t");
+    if (start == std::string_view::npos) {
+        return std::string_view();
+    }
+    std::size_t end = line.find_last_not_of("\r");
+    return line.substr(start, end + 1 - start);
+}
+
+bool parseIntValue(std::string_view text, int& value) {
+    const char* last = text.data() + text.size();
+    auto [ptr, error] = std::from_chars(text.data(), last, value);
+    return error == std::errc() && ptr == last;
+}
+
+bool executeCreate(std::string_view args) {
+    std::string_view kind = nextToken(args);
+    std::string_view type = nextToken(args);
+    std::string_view name = nextToken(args);
+    if (name.empty()) {
+        return false;
+    }
+
+    if (type == "int") {
+        int value = 0;
+        if (!parseIntValue(nextToken(args), value)) {
+            return false;
+        }
+        if (kind == "unique") {
+            storeEntry(name, UniquePtr<int>(new int(value)));
+        } else if (kind == "shared") {
+            storeEntry(name, makeShared<int>(value));
+        } else {
+            return false;
+        }
+    } else if (type == "string") {
+        std::string_view value = restOfLine(args);
+        if (kind == "unique") {
+            storeEntry(name, UniquePtr<std::string>(new std::string(value)));
+        } else if (kind == "shared") {
+            storeEntry(name, makeShared<std::string>(value));
+        } else {
+            return false;
+        }
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool executeTransfer(std::string_view args, bool copy) {
+    std::string_view kind = nextToken(args);
+    std::string_view type = nextToken(args);
+    std::string_view name = nextToken(args);
+    std::string_view source = nextToken(args);
+    if (name.empty() || source.empty()) {
+        return false;
+    }
+
+    if (kind == "unique" && !copy) {
+        if (type == "int") return moveEntry<UniquePtr<int>>(name, source);
+        if (type == "string") return moveEntry<UniquePtr<std::string>>(name, source);
+    } else if (kind == "shared") {
+        if (type == "int") {
+            return copy ? copyEntry<SharedPtr<int>>(name, source) : moveEntry<SharedPtr<int>>(name, source);
+        }
+        if (type == "string") {
+            return copy ? copyEntry<SharedPtr<std::string>>(name, source) : moveEntry<SharedPtr<std::string>>(name, source);
+        }
+    }
+    return false; // UniquePtr копировать нельзя
+}
+
+bool executeDelete(std::string_view args) {
+    std::string_view kind = nextToken(args);
+    std::string_view name = nextToken(args);
+    if (kind == "unique") {
+        return eraseEntry<UniquePtr<int>, UniquePtr<std::string>>(name) != 0;
+    }
+    if (kind == "shared") {
+        return eraseEntry<SharedPtr<int>, SharedPtr<std::string>>(name) != 0;
+    }
+    return false;
+}
+
+// save и load: ошибка снимка печатается и засчитывается как ошибка команды
+bool executeSnapshot(std::string_view args, bool save) {
+    const std::string path(restOfLine(args));
+    if (path.empty()) {
+        return false;
+    }
+    try {
+        if (save) {
+            saveRegistry(path);
+        } else {
+            loadRegistry(path);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return false;
+    }
+    return true;
+}
+
+BatchStats runBatch(std::istream& in, std::ostream& out) {
+    BatchStats stats{0, 0, 0.0};
+
+    // Весь ввод читается одним блоком, дальше строки разбираются без копирования
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    const std::string text = buffer.str();
+    std::string_view rest(text);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    long lineNumber = 0;
+    while (!rest.empty()) {
+        std::size_t end = rest.find('\n');
+        std::string_view line = rest.substr(0, end);
+        rest = end == std::string_view::npos ? std::string_view() : rest.substr(end + 1);
+        ++lineNumber;
+
+        std::string_view args = line;
+        std::string_view command = nextToken(args);
+        if (command.empty() || command[0] == '#') {
+            continue;
+        }
+
+        bool ok = false;
+        if (command == "create") {
+            ok = executeCreate(args);
+        } else if (command == "copy") {
+            ok = executeTransfer(args, true);
+        } else if (command == "move") {
+            ok = executeTransfer(args, false);
+        } else if (command == "delete") {
+            ok = executeDelete(args);
+        } else if (command == "append") {
+            std::string_view name = nextToken(args);
+            ok = !name.empty() && appendEntry(name, restOfLine(args));
+        } else if (command == "save") {
+            ok = executeSnapshot(args, true);
+        } else if (command == "load") {
+            ok = executeSnapshot(args, false);
+        } else if (command == "list") {
+            displayPointers(out);
+            ok = true;
+        }
+
+        ++stats.operations;
+        if (!ok) {
+            ++stats.errors;
+            std::cerr << "Строка " << lineNumber << ": не удалось выполнить '" << line << "'\n";
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    stats.seconds = std::chrono::duration<double>(end - start).count();
+    return stats;
+}
+
+int runBatchCommand(int argc, char* argv[]) {
+    if (argc < 1) {
+        std::cerr << "Использование: Lab1 --batch ФАЙЛ|- [--quiet]\n";
+        return 1;
+    }
+    const std::string path = argv[0];
+    const bool quiet = argc > 1 && std::string(argv[1]) == "--quiet";
+
+    std::ofstream nullStream; // Не открыт: вывод list отбрасывается
+    std::ostream& out = quiet ? static_cast<std::ostream&>(nullStream) : std::cout;
+
+    BatchStats stats;
+    if (path == "-") {
+        stats = runBatch(std::cin, out);
+    } else {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "Ошибка при открытии файла " << path << "\n";
+            return 1;
+        }
+        stats = runBatch(file, out);
+    }
+
+    std::cout << "Выполнено операций: " << stats.operations
+              << ", ошибок: " << stats.errors
+              << ", время: " << stats.seconds << " с"
+              << ", операций в секунду: " << (stats.seconds > 0 ? stats.operations / stats.seconds : 0.0) << "\n";
+    return stats.errors == 0 ? 0 : 2;
+}
@@ -1,6 +1,32 @@
 #ifndef INTERFACE_H
 #define INTERFACE_H
 
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
 void displayMenu();
 
+// Итог пакетного выполнения команд реестра
+struct BatchStats {
+    long operations;
+    long errors;
+    double seconds;
+};
+
+BatchStats runBatch(std::istream& in, std::ostream& out);
+
+// Снимок реестра именованных указателей в двоичный файл (Snapshot.hpp).
+// Общие объекты SharedPtr сохраняются один раз, после загрузки они снова общие.
+// При ошибке бросается std::runtime_error
+void saveRegistry(const std::string& path);
+
+// Загрузка заменяет реестр целиком; при ошибке реестр не меняется. Возвращает число имен
+std::size_t loadRegistry(const std::string& path);
+
+void clearRegistry();
+
+// Разбор аргументов после --batch, возвращает код завершения программы
+int runBatchCommand(int argc, char* argv[]);
+
 #endif 
@@ -1,9 +1,28 @@
+#include <cstring>
+
 #include "interface.hpp"
+#include "benchmark.hpp"
+#include "tests.hpp"
+
+int main(int argc, char* argv[]) {
 
-int main() {
+    // Без аргументов - интерактивное меню
+    if (argc > 1 && std::strcmp(argv[1], "--bench") == 0) {
+        return runBenchmarkCommand(argc - 2, argv + 2);
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--batch") == 0) {
+        return runBatchCommand(argc - 2, argv + 2);
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--test") == 0) {
+        functionalTest();
+        return 0;
+    }
 
     displayMenu();
     return 0; 
 }
 
-// g++ main.cpp tests.cpp interface.cpp -o Lab1 -std=c++17
+// g++ main.cpp tests.cpp interface.cpp benchmark.cpp -o Lab1 -std=c++17 -pthread
+// ./Lab1 --bench --suite pointers --reps 7 --cpu 0
+// С учетом выделений памяти (allocs/op и bytes/op в CSV): добавить -DBENCHMARK_COUNT_ALLOCATIONS
+// ./Lab1 --batch trace.txt --quiet
@@ -1,16 +1,54 @@
 #include <iostream>
 #include <vector>
-#include <fstream> //Чтение с файла для графика
-#include <iomanip> //Выравнивание вывода
 #include <chrono> //Время
 #include <memory> // Для STL указателей
 #include <cassert> //Ошибки
+#include <cstdlib> // malloc/free для теста удалителей
+#include <cstdint> // std::uintptr_t для проверки выравнивания
+#include <cstddef> // offsetof для порчи заголовка снимка
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread> // Многопоточные тесты
+#include <mutex> // Стек под мьютексом для сравнения
+#include <shared_mutex> // Читатели списка под блокировкой для сравнения
+#include <atomic>
+#include <forward_list>
+#include <algorithm> // Стандартные алгоритмы поверх итераторов списков
+#include <numeric>
+#include <random>
+#include <sstream> // Сценарий пакетного режима
+#include <unordered_map> // Сравнение с таблицей имен
+#include <fstream>
+#include <cstdio> // std::remove для временных файлов снимков
+
+#ifdef __linux__
+#include <fcntl.h>  // posix_fadvise: выгрузка снимка из кэша страниц
+#include <unistd.h>
+#endif
 
 #include "UniquePtr.hpp"
 #include "SharedPtr.hpp"
+#include "WeakPtr.hpp"
+#include "IntrusivePtr.hpp"
 #include "LinkedListUniquePtr.hpp"
 #include "LinkedListSharedPtr.hpp"
+#include "NodePool.hpp"
+#include "LinkedListUnrolled.hpp"
+#include "SimdSearch.hpp"
+#include "NameTable.hpp"
+#include "AtomicSharedPtr.hpp"
+#include "LockFreeStack.hpp"
+#include "EpochReclaim.hpp"
+#include "Snapshot.hpp"
+#include "OffsetPtr.hpp"
+#include "SharedSegment.hpp"
+#include "LinkedListOffset.hpp"
+#include "CowPtr.hpp"
+#include "BackgroundReclaim.hpp"
 #include "tests.hpp"
+#include "interface.hpp"
+#include "benchmark.hpp"
 
 void testUnqPtrDereferencing() {
     UniquePtr<int> unqPtr(new int(42));
@@ -102,9 +140,11 @@ void testSharedPtrFunctionality() {
 
     // Тест 1: Преобразование SharedPtr<int> в SharedPtr<float>
     SharedPtr<int> intPtr = SharedPtr<int>(new int(42));
-    SharedPtr<float> floatPtr = intPtr;  // Преобразование int в float
-    assert(floatPtr.useCount() == intPtr.useCount()); 
+    SharedPtr<float> floatPtr = intPtr;  // Преобразование int в float: копия значения со своим счетчиком
+    assert(floatPtr.useCount() == 1 && intPtr.useCount() == 1);
     assert(*floatPtr == 42.0f); // Проверка значения после преобразования
+    SharedValueView<float, int> floatView = viewAs<float>(intPtr); // Общий счетчик с intPtr
+    assert(floatView.useCount() == intPtr.useCount() && *floatView == 42.0f);
     std::cout << floatPtr.useCount();
     std::cout << intPtr.useCount();
 
@@ -116,10 +156,1204 @@ void testSharedPtrFunctionality() {
 
     // Тест 3: Проверка корректности счетчика ссылок после нескольких присвоений
     SharedPtr<float> floatPtrCopy = floatPtr;
-    assert(floatPtr.useCount() == 3);
+    assert(floatPtr.useCount() == 2 && intPtr.useCount() == 2);
     assert(*floatPtrCopy == 42.0f); // Проверка значения копии
 }
 
+void testMakeShared() {
+    SharedPtr<int> empty;
+    assert(!empty && empty.useCount() == 0); // Конструктор по умолчанию ничего не выделяет
+
+    SharedPtr<int> shrdPtr = makeShared<int>(7);
+    assert(*shrdPtr == 7 && shrdPtr.useCount() == 1);
+
+    SharedPtr<int> copy = shrdPtr;
+    assert(copy.get() == shrdPtr.get() && shrdPtr.useCount() == 2);
+
+    SharedPtr<BaseTest> basePtr = makeShared<DerivedTest>();
+    assert(dynamic_cast<DerivedTest*>(basePtr.get()) != nullptr);
+
+    SharedPtr<std::string> strPtr = makeShared<std::string>(3, 'a');
+    assert(*strPtr == "aaa");
+    std::cout << "testMakeShared() - PASSED\n"; // makeShared размещает объект и счетчик одним блоком
+}
+
+void testConcurrentSharedPtr() {
+    const int threads = 4;
+    const int copiesPerThread = 10'000;
+    ConcurrentSharedPtr<int> source = makeShared<int, AtomicRefCount>(5);
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&source]() {
+            for (int i = 0; i < copiesPerThread; ++i) {
+                ConcurrentSharedPtr<int> copy = source;
+                assert(*copy == 5);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    assert(source.useCount() == 1);
+    std::cout << "testConcurrentSharedPtr() - PASSED\n"; // Атомарный счетчик не теряет ссылки между потоками
+}
+
+class LifetimeTracker {
+public:
+    explicit LifetimeTracker(bool& alive) : alive(alive) { alive = true; }
+    ~LifetimeTracker() { alive = false; }
+private:
+    bool& alive;
+};
+
+void testWeakPtr() {
+    bool alive = false;
+    WeakPtr<LifetimeTracker> weak;
+    assert(weak.expired() && !weak.lock());
+    {
+        SharedPtr<LifetimeTracker> shrdPtr = makeShared<LifetimeTracker>(alive);
+        weak = shrdPtr;
+        assert(!weak.expired() && weak.useCount() == 1); // Слабая ссылка не увеличивает счетчик
+
+        SharedPtr<LifetimeTracker> locked = weak.lock();
+        assert(locked.get() == shrdPtr.get() && shrdPtr.useCount() == 2);
+    }
+    assert(!alive && weak.expired() && !weak.lock()); // Объект уничтожен с последней сильной ссылкой
+
+    SharedPtr<BaseTest> basePtr(new DerivedTest());
+    WeakPtr<BaseTest> baseWeak = basePtr;
+    WeakPtr<BaseTest> weakCopy = baseWeak;
+    basePtr.reset();
+    assert(baseWeak.expired() && weakCopy.expired());
+    std::cout << "testWeakPtr() - PASSED\n"; // WeakPtr не продлевает жизнь объекта
+}
+
+// Удалитель с состоянием: считает освобожденные объекты
+struct CountingDelete {
+    int* counter;
+    void operator()(int* p) const {
+        ++*counter;
+        delete p;
+    }
+};
+
+void freeDelete(int* p) {
+    std::free(p);
+}
+
+void testUniquePtrDeleter() {
+    static_assert(sizeof(UniquePtr<int>) == sizeof(int*), "Пустой удалитель не должен занимать места");
+    static_assert(sizeof(UniquePtr<int[]>) == sizeof(int*), "Пустой удалитель не должен занимать места");
+
+    int deleted = 0;
+    {
+        UniquePtr<int, CountingDelete> first(new int(1), CountingDelete{&deleted});
+        UniquePtr<int, CountingDelete> second = std::move(first); // Удалитель переносится вместе с объектом
+        assert(!first && *second == 1 && second.getDeleter().counter == &deleted);
+        second.reset(new int(2));
+        assert(deleted == 1);
+    }
+    assert(deleted == 2);
+
+    int* raw = static_cast<int*>(std::malloc(sizeof(int)));
+    *raw = 5;
+    UniquePtr<int, void(*)(int*)> mallocPtr(raw, freeDelete);
+    assert(*mallocPtr == 5);
+
+    UniquePtr<DerivedTest> derivedPtr(new DerivedTest());
+    UniquePtr<BaseTest> basePtr = std::move(derivedPtr);
+    assert(basePtr && !derivedPtr);
+    std::cout << "testUniquePtrDeleter() - PASSED\n"; // Пользовательские удалители работают без лишнего места
+}
+
+void testLinkedListPool() {
+    // Ресурс задается явно: неявный ресурс потока освобождался бы раньше узлов другого потока
+    static_assert(!std::is_default_constructible<PoolAllocator<int>>::value, "PoolAllocator требует PoolResource");
+    PoolResource pool;
+    SmartPointer::LinkedListUnique<int, PoolAllocator<int>> uniqueList{PoolAllocator<int>(pool)};
+    SmartPointer::LinkedListShared<int, PoolAllocator<int>> sharedList{PoolAllocator<int>(pool)};
+    for (int i = 0; i < 10; ++i) {
+        uniqueList.pushFront(i);
+        sharedList.pushFront(i);
+    }
+    assert(uniqueList.find(3) && sharedList.find(3));
+    assert(pool.reservedBytes() > 0); // Узлы взяты из пула
+
+    const std::size_t reserved = pool.reservedBytes();
+    for (int i = 0; i < 5; ++i) {
+        uniqueList.popFront();
+        sharedList.popFront();
+    }
+    for (int i = 0; i < 5; ++i) {
+        uniqueList.pushFront(100 + i);
+        sharedList.pushFront(100 + i);
+    }
+    assert(pool.reservedBytes() == reserved); // Освобожденные узлы переиспользуются
+    assert(!uniqueList.find(9) && uniqueList.find(104) && sharedList.find(4));
+
+    SmartPointer::LinkedListUnique<std::string> stringList;
+    stringList.pushFront("a");
+    stringList.pushFront("b");
+    stringList.popFront();
+    assert(stringList.find("a") && !stringList.find("b"));
+    std::cout << "testLinkedListPool() - PASSED\n"; // Списки работают с пулом узлов и с std::allocator
+}
+
+void testLinkedListTeardown() {
+    const int items = 1'000'000; // При рекурсивном удалении такой список переполнял стек
+    {
+        SmartPointer::LinkedListUnique<int> uniqueList;
+        SmartPointer::LinkedListShared<int> sharedList;
+        for (int i = 0; i < items; ++i) {
+            uniqueList.pushFront(i);
+            sharedList.pushFront(i);
+        }
+        SmartPointer::LinkedListShared<int> sharedCopy = sharedList;
+        sharedList.clear();
+        assert(!sharedList.find(0) && sharedCopy.find(0)); // Общие узлы остались у копии
+        uniqueList.clear();
+        assert(!uniqueList.find(0));
+        uniqueList.pushFront(1);
+        assert(uniqueList.find(1));
+    }
+
+    ArenaResource arena;
+    {
+        SmartPointer::LinkedListUnique<int, ArenaAllocator<int>> arenaList{ArenaAllocator<int>(arena)};
+        for (int i = 0; i < items; ++i) {
+            arenaList.pushFront(i);
+        }
+        assert(arenaList.find(0));
+    } // Деструктор списка не обходит узлы
+    assert(arena.reservedBytes() > 0);
+    arena.release();
+    assert(arena.reservedBytes() == 0);
+
+    // Пул, принадлежащий одному списку: очистка возвращает все куски пула без обхода узлов
+    PoolResource ownedPool;
+    {
+        using OwnedPool = PoolAllocator<int, true>;
+        SmartPointer::LinkedListUnique<int, OwnedPool> poolList{OwnedPool(ownedPool)};
+        for (int i = 0; i < items; ++i) {
+            poolList.pushFront(i);
+        }
+        assert(ownedPool.reservedBytes() > 0);
+        poolList.clear();
+        assert(ownedPool.reservedBytes() == 0 && !poolList.find(0));
+        poolList.pushFront(1); // Пул снова выдает узлы
+        assert(poolList.find(1) && ownedPool.reservedBytes() > 0);
+
+        SmartPointer::LinkedListUnique<int, OwnedPool> moved = std::move(poolList);
+        poolList.clear(); // Пустой список после переноса не освобождает узлы нового владельца
+        assert(moved.find(1) && ownedPool.reservedBytes() > 0);
+    }
+    assert(ownedPool.reservedBytes() == 0);
+    std::cout << "testLinkedListTeardown() - PASSED\n"; // Длинные списки удаляются без рекурсии
+}
+
+class IntrusiveBase : public RefCounted<> {
+public:
+    virtual ~IntrusiveBase() = default;
+};
+
+class IntrusiveDerived : public IntrusiveBase {
+public:
+    explicit IntrusiveDerived(int value) : value(value) {}
+    int value;
+};
+
+void testIntrusivePtr() {
+    static_assert(sizeof(IntrusivePtr<IntrusiveBase>) == sizeof(void*), "IntrusivePtr - одно слово");
+
+    IntrusivePtr<IntrusiveDerived> derivedPtr = makeIntrusive<IntrusiveDerived>(42);
+    assert(derivedPtr.useCount() == 1 && derivedPtr->value == 42);
+
+    IntrusivePtr<IntrusiveBase> basePtr = derivedPtr;
+    assert(derivedPtr.useCount() == 2);
+
+    IntrusivePtr<IntrusiveDerived> fromRaw(derivedPtr.get()); // Владеющий указатель из сырого без выделения памяти
+    assert(fromRaw.useCount() == 3 && fromRaw.get() == derivedPtr.get());
+
+    fromRaw.reset();
+    derivedPtr = IntrusivePtr<IntrusiveDerived>();
+    assert(basePtr.useCount() == 1);
+
+    struct AtomicObject : RefCounted<AtomicRefCount> {};
+    IntrusivePtr<AtomicObject> atomicPtr = makeIntrusive<AtomicObject>();
+    IntrusivePtr<AtomicObject> atomicCopy = atomicPtr;
+    assert(atomicPtr.useCount() == 2);
+    std::cout << "testIntrusivePtr() - PASSED\n"; // Счетчик внутри объекта работает для обеих политик
+}
+
+void testLinkedListUnrolled() {
+    SmartPointer::LinkedListUnrolled<int, 4> list;
+    for (int i = 0; i < 10; ++i) {
+        list.pushFront(i);
+    }
+    assert(list.find(0) && list.find(9) && !list.find(10));
+    for (int i = 0; i < 6; ++i) {
+        list.popFront(); // Освобождает первый узел целиком и начинает следующий
+    }
+    assert(!list.find(9) && !list.find(4) && list.find(3) && list.find(0));
+
+    SmartPointer::LinkedListUnrolled<std::string> strings;
+    strings.pushFront("a");
+    strings.pushFront("b");
+    strings.popFront();
+    assert(strings.find("a") && !strings.find("b"));
+    strings.popFront();
+    strings.popFront(); // Пустой список не ломается
+    assert(!strings.find("a"));
+    std::cout << "testLinkedListUnrolled() - PASSED\n"; // Развернутый список хранит элементы блоками
+}
+
+template <typename T>
+void checkSimdSearch() {
+    std::vector<T> data;
+    for (int i = 0; i < 37; ++i) {
+        data.push_back(static_cast<T>(i % 7));
+    }
+    for (std::size_t n = 0; n <= data.size(); ++n) { // Все длины хвоста после векторной части
+        for (int value = 0; value < 8; ++value) {
+            const T needle = static_cast<T>(value);
+            assert(SimdSearch::find(data.data(), n, needle) == SimdSearch::scalarFind(data.data(), n, needle));
+            assert(SimdSearch::count(data.data(), n, needle) == SimdSearch::scalarCount(data.data(), n, needle));
+        }
+    }
+}
+
+void testSimdSearch() {
+    checkSimdSearch<char>();
+    checkSimdSearch<short>();
+    checkSimdSearch<int>();
+    checkSimdSearch<long long>();
+    checkSimdSearch<unsigned>();
+    checkSimdSearch<float>();
+    checkSimdSearch<double>();
+
+    std::vector<char> bytes(10'000, 1); // Больше 255 блоков: 8-битные счетчики должны сбрасываться
+    assert(SimdSearch::count(bytes.data(), bytes.size(), char(1)) == bytes.size());
+
+    SmartPointer::LinkedListUnrolled<int, 8> list;
+    SmartPointer::LinkedListUnique<int> uniqueList;
+    for (int i = 0; i < 100; ++i) {
+        list.pushFront(i % 10);
+        uniqueList.pushFront(i % 10);
+    }
+    assert(list.count(3) == 10 && uniqueList.count(3) == 10 && list.count(10) == 0);
+    std::cout << "testSimdSearch() - PASSED\n"; // Векторный поиск совпадает с обычным циклом
+}
+
+void testBatchMode() {
+    std::istringstream script(
+        "# сценарий для проверки\n"
+        "create shared int __testA 42\n"
+        "copy shared int __testB __testA\n"
+        "create unique string __testS hello world\n"
+        "move unique string __testT __testS\n"
+        "\n"
+        "create shared int __testBad 4x2\n"
+        "copy unique int __testC __testA\n"
+        "list\n"
+        "delete shared __testA\n"
+        "delete shared __testB\n"
+        "delete unique __testS\n"
+        "delete unique __testT\n");
+    std::ostringstream out;
+    std::streambuf* errBuf = std::cerr.rdbuf(nullptr); // Ожидаемые ошибки не печатаются
+    BatchStats stats = runBatch(script, out);
+    std::cerr.rdbuf(errBuf);
+
+    assert(stats.operations == 11);
+    assert(stats.errors == 2);
+    const std::string listing = out.str();
+    assert(listing.find("Имя: __testB, Значение: 42, Счетчик ссылок: 2") != std::string::npos);
+    assert(listing.find("Имя: __testT, Значение: hello world") != std::string::npos);
+    assert(listing.find("__testBad") == std::string::npos);
+
+    // У каждого вида указателей свои имена: одно имя у разных видов не заменяет другое
+    std::istringstream kinds(
+        "create unique int __kindX 1\n"
+        "create shared int __kindX 2\n"
+        "create shared string __kindX two\n"
+        "delete shared __kindX\n"
+        "list\n"
+        "delete shared __kindX\n"
+        "delete unique __kindX\n"
+        "delete unique __kindX\n");
+    std::ostringstream kindsOut;
+    std::cerr.rdbuf(nullptr);
+    stats = runBatch(kinds, kindsOut);
+    std::cerr.rdbuf(errBuf);
+    assert(stats.operations == 8 && stats.errors == 1); // Последнее удаление - имени уже нет
+    const std::string kindsListing = kindsOut.str();
+    assert(kindsListing.find("Имя: __kindX, Значение: 1\n") != std::string::npos);
+    assert(kindsListing.find("Имя: __kindX, Значение: 2,") == std::string::npos); // Удален shared int
+    assert(kindsListing.find("Имя: __kindX, Значение: two, Счетчик ссылок: 1") != std::string::npos);
+    std::cout << "testBatchMode() - PASSED\n"; // Команды выполняются без интерактивного ввода
+}
+
+void testNameTable() {
+    NameTable<SharedPtr<int>> table;
+    assert(table.find("missing") == nullptr && !table.erase("missing"));
+    bool tooLarge = false;
+    try {
+        table.reserve(std::numeric_limits<std::size_t>::max()); // Емкость не должна переполниться по кругу
+    } catch (const std::length_error&) {
+        tooLarge = true;
+    }
+    assert(tooLarge && table.capacity() <= 16);
+
+    const int names = 1000; // Несколько перестроений таблицы
+    for (int i = 0; i < names; ++i) {
+        auto [value, inserted] = table.tryEmplace("name" + std::to_string(i));
+        assert(inserted);
+        *value = makeShared<int>(i);
+    }
+    assert(table.size() == names && !table.tryEmplace("name7").second);
+
+    // Удаление каждого третьего имени: обратный сдвиг не должен терять остальные
+    for (int i = 0; i < names; i += 3) {
+        assert(table.erase("name" + std::to_string(i)));
+    }
+    for (int i = 0; i < names; ++i) {
+        const std::string name = "name" + std::to_string(i);
+        const SharedPtr<int>* value = table.find(std::string_view(name));
+        assert((value == nullptr) == (i % 3 == 0));
+        assert(value == nullptr || **value == i);
+    }
+
+    assert(!table.eraseIf("name1", [](const SharedPtr<int>& p) { return *p != 1; }));
+    assert(table.eraseIf("name1", [](const SharedPtr<int>& p) { return *p == 1; }));
+
+    std::size_t visited = 0;
+    table.forEach([&visited](std::string_view, const SharedPtr<int>&) { ++visited; });
+    assert(visited == table.size());
+    std::cout << "testNameTable() - PASSED\n"; // Поиск по string_view, удаление без надгробий
+}
+
+void testAtomicSharedPtr() {
+    AtomicSharedPtr<int> atomicPtr(makeShared<int, AtomicRefCount>(1));
+    assert(atomicPtr.isLockFree());
+
+    ConcurrentSharedPtr<int> first = atomicPtr.load();
+    assert(*first == 1 && first.useCount() == 2); // Копия у вызывающего и ссылка внутри AtomicSharedPtr
+
+    ConcurrentSharedPtr<int> old = atomicPtr.exchange(makeShared<int, AtomicRefCount>(2));
+    assert(old.get() == first.get() && first.useCount() == 2); // Ссылка слова перешла в old
+
+    ConcurrentSharedPtr<int> expected = first;
+    assert(!atomicPtr.compareExchange(expected, makeShared<int, AtomicRefCount>(3)));
+    assert(*expected == 2); // Неудачное сравнение возвращает текущее значение
+    assert(atomicPtr.compareExchange(expected, makeShared<int, AtomicRefCount>(3)));
+    assert(*atomicPtr.load() == 3 && expected.useCount() == 1);
+
+    atomicPtr.store(ConcurrentSharedPtr<int>());
+    assert(!atomicPtr.load());
+
+    // Нагрузка: потоки кладут и снимают значения, каждое должно быть снято ровно один раз
+    const int threads = 4;
+    const int perThread = 20'000;
+    SmartPointer::LockFreeStack<int> stack;
+    std::vector<long long> sums(threads, 0);
+    std::vector<int> popped(threads, 0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&stack, &sums, &popped, t]() {
+            for (int i = 0; i < perThread; ++i) {
+                stack.pushFront(t * perThread + i);
+                int value = 0;
+                if (i % 2 == 1 && stack.popFront(value)) { // Вершина часто меняется между потоками
+                    sums[t] += value;
+                    ++popped[t];
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    long long total = 0;
+    int count = 0;
+    for (int t = 0; t < threads; ++t) {
+        total += sums[t];
+        count += popped[t];
+    }
+    int value = 0;
+    while (stack.popFront(value)) {
+        total += value;
+        ++count;
+    }
+    const long long n = static_cast<long long>(threads) * perThread;
+    assert(count == n && total == n * (n - 1) / 2 && stack.empty());
+    std::cout << "testAtomicSharedPtr() - PASSED\n"; // Без потерянных и повторных значений в стеке
+}
+
+void testEpochReclaim() {
+    // Узел держит копию SharedPtr: счетчик показывает, освобожден ли узел
+    SharedPtr<int> tracked = makeShared<int>(7);
+    {
+        SmartPointer::LinkedListUnique<SharedPtr<int>, std::allocator<SharedPtr<int>>, SmartPointer::EpochReclaim> list;
+        for (int i = 0; i < 10; ++i) {
+            list.pushFront(tracked);
+        }
+        assert(tracked.useCount() == 11);
+        {
+            SmartPointer::EpochGuard reader; // Читатель в середине обхода
+            for (int i = 0; i < 5; ++i) {
+                list.popFront();
+                list.collectRetired();
+            }
+            assert(list.retiredCount() == 5 && tracked.useCount() == 11); // Снятые узлы ждут читателя
+        }
+        list.collectRetired();
+        list.collectRetired();
+        list.collectRetired();
+        assert(list.retiredCount() == 0 && tracked.useCount() == 6);
+    }
+    assert(tracked.useCount() == 1);
+
+    // Писатель снимает и добавляет узлы, пока читатели обходят список без блокировок
+    SmartPointer::LinkedListUnique<int, std::allocator<int>, SmartPointer::EpochReclaim> list;
+    for (int i = 0; i < 1000; ++i) {
+        list.pushFront(i);
+    }
+    std::atomic<bool> done{false};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&list, &done]() {
+            while (!done.load()) {
+                assert(!list.find(-1));
+                assert(list.count(-1) == 0);
+            }
+        });
+    }
+    for (int i = 0; i < 20'000; ++i) {
+        list.popFront();
+        list.pushFront(i);
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    // Читателей больше, чем ячеек: лишний поток получает исключение, а не ждет вечно
+    const std::size_t crowd = SmartPointer::EpochDomain::maxThreads + 1;
+    std::atomic<std::size_t> entered{0};
+    std::atomic<std::size_t> refused{0};
+    std::atomic<bool> leave{false};
+    std::vector<std::thread> crowdThreads;
+    for (std::size_t i = 0; i < crowd; ++i) {
+        crowdThreads.emplace_back([&entered, &refused, &leave]() {
+            try {
+                SmartPointer::EpochGuard guard;
+                entered.fetch_add(1);
+                while (!leave.load()) {
+                    std::this_thread::yield();
+                }
+            } catch (const std::runtime_error&) {
+                refused.fetch_add(1);
+            }
+        });
+    }
+    while (entered.load() + refused.load() < crowd) {
+        std::this_thread::yield();
+    }
+    leave = true;
+    for (auto& thread : crowdThreads) {
+        thread.join();
+    }
+    assert(refused >= 1 && entered <= SmartPointer::EpochDomain::maxThreads);
+    std::cout << "testEpochReclaim() - PASSED\n"; // Снятые узлы освобождаются только после читателей
+}
+
+void testAlignedArray() {
+    AlignedArray<float> zeros = makeUniqueArray<float>(1000);
+    assert(zeros.size() == 1000);
+    assert(reinterpret_cast<std::uintptr_t>(zeros.get()) % cacheLineSize == 0);
+    float sum = 0;
+    for (float value : zeros) { // Диапазон берется из самого указателя
+        sum += value;
+    }
+    assert(sum == 0.0f);
+
+    AlignedArray<int> buffer = makeUniqueArrayForOverwrite<int>(100, 4096);
+    assert(reinterpret_cast<std::uintptr_t>(buffer.get()) % 4096 == 0);
+    int next = 0;
+    for (int& value : buffer) {
+        value = next++;
+    }
+    assert(buffer[99] == 99);
+
+    AlignedArray<int> moved = std::move(buffer);
+    assert(moved.size() == 100 && buffer.size() == 0 && buffer.begin() == buffer.end());
+
+    // Нетривиальные элементы разрушаются вместе с массивом
+    SharedPtr<int> tracked = makeShared<int>(1);
+    {
+        AlignedArray<SharedPtr<int>> pointers = makeUniqueArray<SharedPtr<int>>(10);
+        for (auto& ptr : pointers) {
+            ptr = tracked;
+        }
+        assert(tracked.useCount() == 11);
+    }
+    assert(tracked.useCount() == 1);
+
+    bool rejected = false;
+    try {
+        makeUniqueArray<double>(10, 3);
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    assert(rejected);
+    std::cout << "testAlignedArray() - PASSED\n"; // Выровненный массив знает свою длину
+}
+
+void testAllocationCounting() {
+    if (!allocationCountingEnabled()) {
+        std::cout << "testAllocationCounting() - SKIPPED (сборка без -DBENCHMARK_COUNT_ALLOCATIONS)\n";
+        return;
+    }
+    const AllocationStats before = allocationSnapshot();
+    {
+        SharedPtr<int> empty; // Пустой SharedPtr ничего не выделяет
+        SharedPtr<int> shared = makeShared<int>(1); // Объект и счетчик одним блоком
+        AlignedArray<double> aligned = makeUniqueArray<double>(16, 256);
+    }
+    const AllocationStats after = allocationSnapshot();
+    assert(after.allocations - before.allocations == 2);
+    assert(after.frees - before.frees == 2);
+    assert(after.bytes - before.bytes >= static_cast<long long>(16 * sizeof(double) + sizeof(int)));
+    assert(after.liveBytes == before.liveBytes);
+    std::cout << "testAllocationCounting() - PASSED\n"; // Учет выделений видит все формы operator new
+}
+
+// Считает копирования: вставка через emplaceFront и pushFront(T&&) не должна копировать
+struct CopyCounter {
+    static int copies;
+    std::string value;
+
+    explicit CopyCounter(std::string v) : value(std::move(v)) {}
+    CopyCounter(const CopyCounter& other) : value(other.value) { ++copies; }
+    CopyCounter(CopyCounter&& other) noexcept : value(std::move(other.value)) {}
+
+    bool operator==(const CopyCounter& other) const { return value == other.value; }
+};
+
+int CopyCounter::copies = 0;
+
+template <typename List>
+std::vector<int> listValues(const List& list) {
+    return std::vector<int>(list.begin(), list.end());
+}
+
+void testListInsertionAndSplice() {
+    CopyCounter::copies = 0;
+    SmartPointer::LinkedListUnique<CopyCounter> uniqueStrings;
+    SmartPointer::LinkedListShared<CopyCounter> sharedStrings;
+    uniqueStrings.emplaceFront("emplaced");
+    sharedStrings.emplaceFront("emplaced");
+    uniqueStrings.pushFront(CopyCounter("moved"));
+    sharedStrings.pushFront(CopyCounter("moved"));
+    assert(CopyCounter::copies == 0);
+    assert(uniqueStrings.find(CopyCounter("emplaced")) && sharedStrings.find(CopyCounter("moved")));
+    assert(CopyCounter::copies == 0); // find принимает const T&
+
+    // Итераторы: списки работают со стандартными алгоритмами без копирования
+    SmartPointer::LinkedListUnique<int> a;
+    SmartPointer::LinkedListUnique<int> b;
+    for (int i = 3; i >= 1; --i) {
+        a.pushFront(i);     // 1 2 3
+        b.pushFront(i * 10); // 10 20 30
+    }
+    assert(std::accumulate(a.begin(), a.end(), 0) == 6);
+    assert(std::distance(a.begin(), a.end()) == 3);
+    assert(*std::find(a.cbegin(), a.cend(), 2) == 2);
+    for (int& value : a) {
+        value *= 2; // 2 4 6
+    }
+
+    const int* movedNode = &*b.begin();
+    a.transferFront(b); // 10 2 4 6 | 20 30
+    assert(&*a.begin() == movedNode); // Узел перевязан, а не скопирован
+    a.transferAfter(std::next(a.cbegin(), 3), b); // 10 2 4 6 20 | 30
+    a.spliceAfter(a.cbegin(), b); // 10 30 2 4 6 20 |
+    assert((listValues(a) == std::vector<int>{10, 30, 2, 4, 6, 20}) && b.begin() == b.end());
+
+    b.pushFront(-1);
+    b.spliceFront(a);
+    assert((listValues(b) == std::vector<int>{10, 30, 2, 4, 6, 20, -1}) && a.begin() == a.end());
+
+    // Узлы из разных пулов: каждый узел возвращается в свой пул
+    PoolResource firstPool;
+    PoolResource secondPool;
+    {
+        SmartPointer::LinkedListUnique<int, PoolAllocator<int>> first{PoolAllocator<int>(firstPool)};
+        SmartPointer::LinkedListUnique<int, PoolAllocator<int>> second{PoolAllocator<int>(secondPool)};
+        first.pushFront(1);
+        second.pushFront(2);
+        first.spliceFront(second);
+        assert((listValues(first) == std::vector<int>{2, 1}));
+    }
+
+    // LinkedListShared: узлы перевязываются, пока их не видит копия списка
+    SmartPointer::LinkedListShared<int> s;
+    SmartPointer::LinkedListShared<int> t;
+    s.pushFront(1);
+    t.pushFront(3);
+    t.pushFront(2);
+    const int* sharedNode = &*t.begin();
+    s.transferFront(t); // 2 1 | 3
+    assert(&*s.begin() == sharedNode && (listValues(s) == std::vector<int>{2, 1}));
+
+    SmartPointer::LinkedListShared<int> snapshot = t; // Копия делит узлы с t
+    s.spliceFront(t); // Узлы видит snapshot: значения копируются
+    assert((listValues(s) == std::vector<int>{3, 2, 1}) && t.begin() == t.end());
+    assert((listValues(snapshot) == std::vector<int>{3}));
+
+    // После позиции: без копий списка узлы перевязываются
+    SmartPointer::LinkedListShared<int> u;
+    u.pushFront(5);
+    u.pushFront(4); // 4 5
+    const int* relinked = &*u.begin();
+    s.transferAfter(std::next(s.cbegin()), u); // 3 2 4 1 | 5
+    assert(&*std::next(s.cbegin(), 2) == relinked && (listValues(s) == std::vector<int>{3, 2, 4, 1}));
+    s.spliceAfter(s.cbegin(), u); // 3 5 2 4 1 |
+    assert((listValues(s) == std::vector<int>{3, 5, 2, 4, 1}) && u.begin() == u.end());
+
+    // Узлы до pos видит копия: они копируются, копия не меняется, общий хвост не копируется
+    SmartPointer::LinkedListShared<int> before = s;
+    const int* sharedTail = &*std::next(before.cbegin(), 3);
+    u.pushFront(7);
+    u.pushFront(6);
+    SmartPointer::LinkedListShared<int> source = u; // Копия делит узлы с u
+    s.transferAfter(std::next(s.cbegin(), 2), u); // 3 5 2 6 4 1 | 7
+    s.spliceAfter(s.cbegin(), u); // 3 7 5 2 6 4 1 |
+    assert((listValues(s) == std::vector<int>{3, 7, 5, 2, 6, 4, 1}) && u.begin() == u.end());
+    assert((listValues(before) == std::vector<int>{3, 5, 2, 4, 1}));
+    assert((listValues(source) == std::vector<int>{6, 7}));
+    assert(&*std::next(s.cbegin(), 5) == sharedTail);
+    std::cout << "testListInsertionAndSplice() - PASSED\n"; // Вставка без копий, перевязка узлов, итераторы
+}
+
+// Сравнение только по ключу: проверка устойчивости сортировки
+struct SortKey {
+    int key;
+    int order;
+};
+
+bool lessByKey(const SortKey& a, const SortKey& b) {
+    return a.key < b.key;
+}
+
+template <typename List>
+std::vector<int> listOrders(const List& list) {
+    std::vector<int> orders;
+    for (const SortKey& item : list) {
+        orders.push_back(item.order);
+    }
+    return orders;
+}
+
+void testListSortAndMerge() {
+    // Последовательная и параллельная сортировка дают тот же результат, что std::stable_sort
+    const int sizes[] = {0, 1, 2, 7, 1000, 300000};
+    for (int n : sizes) {
+        std::vector<SortKey> expected;
+        SmartPointer::LinkedListUnique<SortKey> sequential;
+        SmartPointer::LinkedListUnique<SortKey> parallel;
+        for (int i = n - 1; i >= 0; --i) {
+            const SortKey item{static_cast<int>((i * 7919L) % 97), i};
+            sequential.pushFront(item);
+            parallel.pushFront(item);
+        }
+        for (int i = 0; i < n; ++i) {
+            expected.push_back({static_cast<int>((i * 7919L) % 97), i});
+        }
+        std::stable_sort(expected.begin(), expected.end(), lessByKey);
+        const int* firstNode = n > 0 ? &sequential.begin()->order : nullptr;
+
+        sequential.sort(lessByKey);
+        parallel.parallelSort(4, lessByKey); // 300000 узлов - 4 потока
+        std::vector<int> expectedOrders;
+        for (const SortKey& item : expected) {
+            expectedOrders.push_back(item.order);
+        }
+        assert(listOrders(sequential) == expectedOrders && listOrders(parallel) == expectedOrders);
+        if (n > 0) {
+            assert(std::find_if(sequential.begin(), sequential.end(), [firstNode](const SortKey& item) {
+                       return &item.order == firstNode;
+                   }) != sequential.end()); // Узлы перевязаны, не скопированы
+        }
+    }
+
+    SmartPointer::LinkedListUnique<int> descending;
+    for (int value : {3, 1, 2}) {
+        descending.pushFront(value);
+    }
+    descending.sort(std::greater<int>());
+    assert((listValues(descending) == std::vector<int>{3, 2, 1}));
+
+    // Слияние: из равных первыми идут элементы левого списка, other пустеет
+    SmartPointer::LinkedListUnique<SortKey> left;
+    SmartPointer::LinkedListUnique<SortKey> right;
+    for (int key : {5, 3, 1}) {
+        left.pushFront({key, 0});
+        right.pushFront({key + 1, 1});
+    }
+    left.pushFront({1, 0});
+    right.pushFront({1, 1});
+    left.merge(right, lessByKey); // 1 1 | 1 2 3 4 5 6
+    assert((listOrders(left) == std::vector<int>{0, 0, 1, 1, 0, 1, 0, 1}) && right.begin() == right.end());
+    assert(std::is_sorted(left.begin(), left.end(), lessByKey));
+
+    // Узлы из разных пулов остаются со своими удалителями
+    PoolResource firstPool;
+    PoolResource secondPool;
+    {
+        SmartPointer::LinkedListUnique<int, PoolAllocator<int>> first{PoolAllocator<int>(firstPool)};
+        SmartPointer::LinkedListUnique<int, PoolAllocator<int>> second{PoolAllocator<int>(secondPool)};
+        for (int i = 0; i < 100; ++i) {
+            first.pushFront(i * 2);
+            second.pushFront(i * 2 + 1);
+        }
+        first.merge(second);
+        first.sort();
+        first.spliceFront(second);
+        assert(std::is_sorted(first.begin(), first.end()) && std::distance(first.begin(), first.end()) == 200);
+    }
+
+    // Исключение сравнения не теряет элементы
+    SmartPointer::LinkedListUnique<int> throwing;
+    for (int i = 0; i < 500; ++i) {
+        throwing.pushFront((i * 31) % 500);
+    }
+    int comparisons = 0;
+    try {
+        throwing.sort([&comparisons](int a, int b) {
+            if (++comparisons == 1000) {
+                throw std::runtime_error("comparison failed");
+            }
+            return a < b;
+        });
+        assert(false);
+    } catch (const std::runtime_error&) {
+    }
+    std::vector<int> restored(throwing.begin(), throwing.end());
+    std::sort(restored.begin(), restored.end());
+    std::vector<int> all(500);
+    std::iota(all.begin(), all.end(), 0);
+    assert(restored == all);
+    std::cout << "testListSortAndMerge() - PASSED\n"; // Сортировка и слияние перевязкой узлов
+}
+
+void testListBulkAssign() {
+    std::vector<int> values(300000);
+    std::iota(values.begin(), values.end(), 0);
+
+    // Последовательная и параллельная сборка сохраняют порядок диапазона
+    SmartPointer::LinkedListUnique<int> unique(values.begin(), values.end());
+    SmartPointer::LinkedListUnique<int> uniqueParallel;
+    uniqueParallel.pushFront(-1); // Старое содержимое заменяется
+    uniqueParallel.parallelAssign(4, values.begin(), values.end());
+    assert(std::equal(unique.begin(), unique.end(), values.begin(), values.end()));
+    assert(std::equal(uniqueParallel.begin(), uniqueParallel.end(), values.begin(), values.end()));
+
+    SmartPointer::LinkedListShared<int> shared = SmartPointer::LinkedListShared<int>::fromRange(values);
+    SmartPointer::LinkedListShared<int> snapshot = shared;
+    shared.parallelAssign(4, values.rbegin(), values.rend());
+    assert(std::equal(shared.begin(), shared.end(), values.rbegin(), values.rend()));
+    assert(std::equal(snapshot.begin(), snapshot.end(), values.begin(), values.end())); // Копия не изменилась
+
+    // Прямой итератор и пул: сборка в текущем потоке
+    std::forward_list<std::string> words{"a", "b", "c"};
+    PoolResource pool;
+    SmartPointer::LinkedListUnique<std::string, PoolAllocator<std::string>> pooled{PoolAllocator<std::string>(pool)};
+    pooled.parallelAssign(4, words.begin(), words.end());
+    assert(std::equal(pooled.begin(), pooled.end(), words.begin(), words.end()));
+    SmartPointer::LinkedListShared<std::string> empty(words.end(), words.end());
+    assert(empty.begin() == empty.end());
+
+    // Каждое значение копируется из диапазона ровно один раз
+    std::vector<CopyCounter> items;
+    items.emplace_back("x");
+    items.emplace_back("y");
+    CopyCounter::copies = 0;
+    SmartPointer::LinkedListUnique<CopyCounter> copied = SmartPointer::LinkedListUnique<CopyCounter>::fromRange(items);
+    assert(CopyCounter::copies == 2 && copied.begin()->value == "x");
+    std::cout << "testListBulkAssign() - PASSED\n"; // Сборка списков из диапазона по порядку, в том числе в нескольких потоках
+}
+
+void testSnapshot() {
+    const std::string path = "__test_snapshot.bin";
+
+    // Список: запись, чтение без копирования и сборка узлов за один проход
+    std::vector<int> values(100000);
+    std::iota(values.begin(), values.end(), -50000);
+    SmartPointer::LinkedListUnique<int> list(values.begin(), values.end());
+    Snapshot::save(path, list);
+    {
+        Snapshot::View<int> view(path);
+        assert(view.size() == values.size() && std::equal(view.begin(), view.end(), values.begin()));
+        assert(reinterpret_cast<std::uintptr_t>(view.data()) % Snapshot::dataAlignment == 0);
+    }
+    ArenaResource arena;
+    SmartPointer::LinkedListUnique<int, ArenaAllocator<int>> restored{ArenaAllocator<int>(arena)};
+    assert(Snapshot::load(path, restored) == values.size());
+    assert(std::equal(restored.begin(), restored.end(), values.begin(), values.end()));
+
+    SmartPointer::LinkedListShared<int> emptyList;
+    Snapshot::save(path, emptyList);
+    assert(Snapshot::load(path, list) == 0 && list.begin() == list.end());
+
+    // Снимок другого вида или поврежденный файл не загружается
+    Snapshot::save(path, values);
+    bool rejected = false;
+    try {
+        Snapshot::View<double> wrongType(path);
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    assert(rejected);
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << "not a snapshot";
+    rejected = false;
+    try {
+        loadRegistry(path);
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    assert(rejected);
+
+    // Реестр: общие объекты SharedPtr остаются общими, пустые указатели сохраняются
+    std::istringstream script(
+        "create shared int __snapA 42\n"
+        "copy shared int __snapB __snapA\n"
+        "create shared string __snapC shared text\n"
+        "create unique string __snapS hello world\n"
+        "create unique int __snapI 7\n"
+        "move unique int __snapJ __snapI\n"
+        "save " + path + "\n"
+        "delete shared __snapA\n"
+        "delete shared __snapB\n"
+        "delete shared __snapC\n"
+        "delete unique __snapS\n"
+        "delete unique __snapJ\n"
+        "load " + path + "\n"
+        "list\n");
+    std::ostringstream out;
+    BatchStats stats = runBatch(script, out);
+    assert(stats.errors == 0);
+    const std::string listing = out.str();
+    assert(listing.find("Имя: __snapB, Значение: 42, Счетчик ссылок: 2") != std::string::npos);
+    assert(listing.find("Имя: __snapC, Значение: shared text, Счетчик ссылок: 1") != std::string::npos);
+    assert(listing.find("Имя: __snapS, Значение: hello world") != std::string::npos);
+    assert(listing.find("Имя: __snapJ, Значение: 7") != std::string::npos);
+
+    // Завышенное число записей в заголовке: файл отвергается до резервирования, реестр не меняется
+    saveRegistry(path);
+    const std::uint64_t hugeCounts[] = {0x3FFFFFFFFFFFFFFFull, std::uint64_t(1) << 27};
+    for (std::uint64_t count : hugeCounts) {
+        std::fstream patched(path, std::ios::binary | std::ios::in | std::ios::out);
+        patched.seekp(offsetof(Snapshot::Header, count));
+        patched.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        patched.close();
+        rejected = false;
+        try {
+            loadRegistry(path);
+        } catch (const std::runtime_error&) {
+            rejected = true;
+        }
+        assert(rejected);
+    }
+    std::istringstream listScript("list\n");
+    std::ostringstream afterRejected;
+    runBatch(listScript, afterRejected);
+    assert(afterRejected.str().find("Имя: __snapB, Значение: 42, Счетчик ссылок: 2") != std::string::npos);
+    clearRegistry();
+    std::remove(path.c_str());
+    std::cout << "testSnapshot() - PASSED\n"; // Снимки списков и реестра через mmap
+}
+
+void testOffsetPtr() {
+    // Копия указателя в другом месте указывает на тот же объект
+    int values[4] = {1, 2, 3, 4};
+    OffsetPtr<int> first(&values[2]);
+    OffsetPtr<int> copies[2] = {first, nullptr};
+    copies[1] = first;
+    assert(copies[0].get() == &values[2] && *copies[1] == 3 && copies[0] == first);
+    assert(!OffsetPtr<int>() && OffsetPtr<int>() == nullptr);
+
+    // Блок копируется по другому адресу целиком: список читается без исправления указателей
+    using OffsetList = SmartPointer::LinkedListOffset<int>;
+    MappedSegment original = MappedSegment::inMemory(1 << 20);
+    OffsetHeap& heap = original.heap();
+    OffsetList* list = heap.construct<OffsetList>(heap);
+    heap.setRoot(list);
+    for (int i = 0; i < 1000; ++i) {
+        list->pushFront(i);
+    }
+    MappedSegment moved = MappedSegment::copyOf(original.data(), original.size());
+    const OffsetList* movedList = moved.heap().root<OffsetList>();
+    assert(movedList != list && movedList->size() == 1000 && movedList->find(0) && !movedList->find(1000));
+    assert(std::equal(movedList->begin(), movedList->end(), list->begin(), list->end()));
+
+    // Освобожденные узлы переиспользуются, место в блоке не растет
+    const std::size_t used = heap.usedBytes();
+    list->popFront();
+    list->pushFront(-1);
+    assert(heap.usedBytes() == used && list->count(-1) == 1);
+
+    // Нехватка места в блоке - std::bad_alloc, список не меняется
+    MappedSegment small = MappedSegment::inMemory(1024);
+    OffsetList* smallList = small.heap().construct<OffsetList>(small.heap());
+    bool exhausted = false;
+    try {
+        for (int i = 0; i < 1000; ++i) {
+            smallList->pushFront(i);
+        }
+    } catch (const std::bad_alloc&) {
+        exhausted = true;
+    }
+    assert(exhausted && smallList->size() == static_cast<std::size_t>(std::distance(smallList->begin(), smallList->end())));
+
+#ifdef SMART_POINTER_HAS_SHARED_MAPPING
+    // Файл сегмента, отображенный дважды по разным адресам: изменения видны в обоих отображениях
+    const std::string path = "__test_segment.bin";
+    {
+        MappedSegment writer = MappedSegment::create(path, 1 << 20);
+        OffsetList* shared = writer.heap().construct<OffsetList>(writer.heap());
+        writer.heap().setRoot(shared);
+        shared->pushFront(10);
+        shared->pushFront(20);
+
+        MappedSegment reader = MappedSegment::open(path);
+        OffsetList* view = reader.heap().root<OffsetList>();
+        assert(view != shared && view->size() == 2 && *view->begin() == 20);
+        view->pushFront(30); // Узел выделяется в общей куче файла
+        assert(shared->size() == 3 && *shared->begin() == 30);
+        writer.flush();
+    }
+    {
+        MappedSegment reopened = MappedSegment::open(path);
+        const OffsetList* restored = reopened.heap().root<OffsetList>();
+        assert((std::vector<int>(restored->begin(), restored->end()) == std::vector<int>{30, 20, 10}));
+    }
+    std::remove(path.c_str());
+#endif
+    heap.destroy(list);
+    std::cout << "testOffsetPtr() - PASSED\n"; // Список в блоке памяти, не зависящий от адреса отображения
+}
+
+struct AliasTarget {
+    int id;
+    float weight;
+};
+
+void testSharedPtrAliasing() {
+    // Совмещение: указатель на поле, счетчик общий с владельцем, без выделения памяти
+    SharedPtr<AliasTarget> owner = makeShared<AliasTarget>(AliasTarget{1, 2.5f});
+    SharedPtr<float> weight(owner, &owner.get()->weight);
+    assert(weight.get() == &owner.get()->weight && *weight == 2.5f);
+    assert(owner.useCount() == 2 && weight.useCount() == 2);
+
+    WeakPtr<float> weakWeight(weight);
+    owner = SharedPtr<AliasTarget>(); // Объект держит совмещенный указатель
+    assert(weight.useCount() == 1 && *weight == 2.5f && !weakWeight.expired());
+
+    SharedPtr<float> moved(std::move(weight), weight.get());
+    assert(!weight && moved.useCount() == 1 && *weakWeight.lock() == 2.5f);
+    moved = SharedPtr<float>();
+    assert(weakWeight.expired()); // Последняя ссылка уничтожила весь объект
+
+    SharedPtr<int> unowned(SharedPtr<AliasTarget>(), nullptr);
+    assert(!unowned && unowned.useCount() == 0);
+
+    // Представление значения: без выделения, видит изменения объекта
+    SharedPtr<int> counter = makeShared<int>(3);
+    SharedValueView<double, int> view = viewAs<double>(counter);
+    *counter.get() = 7;
+    assert(*view == 7.0 && view.useCount() == 2 && view.source().get() == counter.get());
+    counter = SharedPtr<int>();
+    assert(view && *view == 7.0 && view.useCount() == 1);
+
+    // Преобразование числа копирует значение; копия освобождается сама
+    SharedPtr<int> source = makeShared<int>(5);
+    SharedPtr<double> converted;
+    converted = source;
+    *source.get() = 6;
+    assert(*converted == 5.0 && converted.useCount() == 1 && source.useCount() == 1);
+    SharedPtr<double> empty = SharedPtr<int>();
+    assert(!empty);
+    std::cout << "testSharedPtrAliasing() - PASSED\n"; // Совмещение и представления значений без выделений
+}
+
+void testCowPtr() {
+    CowPtr<std::string> original = makeCow<std::string>("shared text");
+    CowPtr<std::string> copy = original; // Чтение не копирует строку
+    assert(copy.useCount() == 2 && &*copy == &*original && copy->size() == 11);
+
+    copy.write() += "!"; // Первая запись разделяемой строки создает копию
+    assert(*original == "shared text" && copy.read() == "shared text!");
+    assert(original.unique() && copy.unique());
+
+    const std::string* before = &copy.read();
+    copy.write() += "?"; // Владелец один: изменение на месте
+    assert(&copy.read() == before && *copy == "shared text!?");
+
+    SharedPtr<std::string> shared = original.shared(); // Ссылка снаружи тоже защищает объект
+    original.write().clear();
+    assert(*shared == "shared text" && original->empty());
+
+    // Копия при записи бросила исключение: CowPtr по-прежнему делит прежний объект
+    struct CopyFails {
+        int value = 1;
+        CopyFails() = default;
+        CopyFails(const CopyFails&) {
+            throw std::runtime_error("copy");
+        }
+    };
+    CowPtr<CopyFails> failing = makeCow<CopyFails>();
+    CowPtr<CopyFails> failingCopy = failing;
+    bool copyThrew = false;
+    try {
+        failingCopy.write().value = 2;
+    } catch (const std::runtime_error&) {
+        copyThrew = true;
+    }
+    assert(copyThrew && failingCopy.useCount() == 2 && failingCopy->value == 1);
+
+    CowPtr<std::string> wrapped(std::move(shared));
+    wrapped.write() = "moved";
+    assert(!shared && *wrapped.takeShared() == "moved" && !wrapped);
+
+    // Слабая ссылка: запись идет в свою копию, lock() не видит изменений
+    CowPtr<std::string> observed = makeCow<std::string>("private");
+    WeakPtr<std::string> observer(observed.shared());
+    assert(observed.unique() && observed.shared().weakCount() == 1);
+    observed.write() += "!";
+    assert(observer.expired() && *observed == "private!");
+
+    // Реестр: append меняет строку одного имени, копии под другими именами не меняются
+    std::istringstream script(
+        "create shared string __cowA base\n"
+        "copy shared string __cowB __cowA\n"
+        "append __cowB -tail\n"
+        "append __cowB -more\n"
+        "append __cowMissing text\n"
+        "create shared int __cowI 1\n"
+        "append __cowI text\n"
+        "list\n"
+        "delete shared __cowA\n"
+        "delete shared __cowB\n"
+        "delete shared __cowI\n");
+    std::ostringstream out;
+    std::streambuf* errBuf = std::cerr.rdbuf(nullptr);
+    BatchStats stats = runBatch(script, out);
+    std::cerr.rdbuf(errBuf);
+    assert(stats.operations == 11 && stats.errors == 2);
+    const std::string listing = out.str();
+    assert(listing.find("Имя: __cowA, Значение: base, Счетчик ссылок: 1") != std::string::npos);
+    assert(listing.find("Имя: __cowB, Значение: base-tail-more, Счетчик ссылок: 1") != std::string::npos);
+    std::cout << "testCowPtr() - PASSED\n"; // Копия строки создается только при записи в разделяемую
+}
+
+// Объект, который запоминает, в каком потоке его удалили
+struct ReclaimProbe {
+    static std::atomic<int> destroyed;
+    static std::atomic<int> destroyedInBackground;
+    static std::thread::id caller;
+
+    UniquePtr<ReclaimProbe, DeferredDelete<ReclaimProbe>> child;
+
+    ~ReclaimProbe() {
+        destroyed.fetch_add(1, std::memory_order_relaxed);
+        if (std::this_thread::get_id() != caller) {
+            destroyedInBackground.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+};
+
+// Удаление ждет, пока тест не выставит released: до этого байты объекта заняты в очереди
+struct ReclaimBlocker {
+    static std::atomic<bool> released;
+    static std::atomic<int> destroyed;
+
+    ~ReclaimBlocker() {
+        while (!released.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        destroyed.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+std::atomic<bool> ReclaimBlocker::released{false};
+std::atomic<int> ReclaimBlocker::destroyed{0};
+std::atomic<int> ReclaimProbe::destroyed{0};
+std::atomic<int> ReclaimProbe::destroyedInBackground{0};
+std::thread::id ReclaimProbe::caller;
+
+void testBackgroundReclaimer() {
+    ReclaimProbe::caller = std::this_thread::get_id();
+    {
+        BackgroundReclaimer reclaimer;
+        using DeferredProbe = UniquePtr<ReclaimProbe, DeferredDelete<ReclaimProbe>>;
+
+        DeferredProbe unique(new ReclaimProbe, DeferredDelete<ReclaimProbe>(reclaimer));
+        unique.reset();
+        reclaimer.flush();
+        assert(ReclaimProbe::destroyed == 1 && ReclaimProbe::destroyedInBackground == 1);
+
+        // Вложенное удаление: дочерний объект ставится в очередь из фонового потока
+        DeferredProbe parent(new ReclaimProbe, DeferredDelete<ReclaimProbe>(reclaimer));
+        parent->child = DeferredProbe(new ReclaimProbe, DeferredDelete<ReclaimProbe>(reclaimer));
+        parent.reset();
+        reclaimer.flush();
+        assert(ReclaimProbe::destroyed == 3 && ReclaimProbe::destroyedInBackground == 3);
+
+        // SharedPtr: ссылка всегда отпускается фоновым потоком, удаляет только последняя
+        SharedPtr<ReclaimProbe> first = makeShared<ReclaimProbe>();
+        SharedPtr<ReclaimProbe> second = first;
+        reclaimer.retire(std::move(second));
+        reclaimer.flush();
+        assert(!second && first.useCount() == 1 && ReclaimProbe::destroyed == 3);
+        reclaimer.retire(std::move(first));
+        assert(!first);
+        reclaimer.flush();
+        assert(ReclaimProbe::destroyed == 4 && ReclaimProbe::destroyedInBackground == 4);
+
+        // Длинный список переносится в очередь целиком, вызывающему остается пустой
+        SmartPointer::LinkedListShared<int> list;
+        for (int i = 0; i < 1'000'000; ++i) {
+            list.pushFront(i);
+        }
+        reclaimer.retireOwner(std::move(list), std::size_t(1'000'000) * 64);
+        assert(list.begin() == list.end());
+        reclaimer.flush();
+        assert(reclaimer.pendingBytes() == 0 && reclaimer.deferredCount() == 6 && reclaimer.inlineCount() == 0);
+    }
+
+    // Объект, не помещающийся в ограничение очереди, удаляется сразу в вызывающем потоке.
+    // Первый объект держит свои байты в очереди, пока тест не разрешит его удалить,
+    // поэтому исход не зависит от того, как быстро работает фоновый поток
+    {
+        BackgroundReclaimer bounded(100);
+        bounded.retire(new ReclaimBlocker, 64);
+        assert(bounded.deferredCount() == 1 && bounded.pendingBytes() == 64);
+        bounded.retire(new ReclaimProbe, 64);
+        assert(bounded.inlineCount() == 1 && bounded.deferredCount() == 1);
+        assert(ReclaimProbe::destroyed == 5 && ReclaimProbe::destroyedInBackground == 4);
+        bounded.retire(new ReclaimProbe, 1000);
+        assert(bounded.inlineCount() == 2 && ReclaimProbe::destroyed == 6);
+        ReclaimBlocker::released.store(true, std::memory_order_release);
+        bounded.flush();
+        assert(bounded.pendingBytes() == 0 && ReclaimBlocker::destroyed == 1);
+    }
+    assert(ReclaimProbe::destroyed == 6 && ReclaimProbe::destroyedInBackground == 4);
+    std::cout << "testBackgroundReclaimer() - PASSED\n"; // Объекты удаляются фоновым потоком, очередь ограничена
+}
+
 void zz() {
     // Должно компилироваться
     UniquePtr<int> uni ( new int(42));
@@ -141,6 +1375,29 @@ void functionalTest() {
     testSharedPtrInheritance();
     testArrayHandling();
     testSharedPtrFunctionality();
+    testMakeShared();
+    testConcurrentSharedPtr();
+    testWeakPtr();
+    testUniquePtrDeleter();
+    testLinkedListPool();
+    testLinkedListTeardown();
+    testIntrusivePtr();
+    testLinkedListUnrolled();
+    testSimdSearch();
+    testNameTable();
+    testBatchMode();
+    testAtomicSharedPtr();
+    testEpochReclaim();
+    testAlignedArray();
+    testAllocationCounting();
+    testListInsertionAndSplice();
+    testListSortAndMerge();
+    testListBulkAssign();
+    testSnapshot();
+    testOffsetPtr();
+    testSharedPtrAliasing();
+    testCowPtr();
+    testBackgroundReclaimer();
     zz();
 
     std::cout << "Функциональное тестирование окончено\n";
@@ -148,8 +1405,9 @@ void functionalTest() {
 
 // Для собственных UniquePtr и SharedPtr
 double loadTestUniquePtr(int N) {
-    std::vector<UniquePtr<int>> buff(N);
+    std::vector<UniquePtr<int>>& buff = scratchBuffer<UniquePtr<int>>(N);
 
+    perfRegionBegin();
     auto start = std::chrono::high_resolution_clock::now();
     for (int i = 0; i < N; ++i) {
         if (i % 5 == 0) {
@@ -159,49 +1417,234 @@ double loadTestUniquePtr(int N) {
         }
     }
     auto end = std::chrono::high_resolution_clock::now();
+    perfRegionEnd();
     std::chrono::duration<double> duration = end - start;
 
+    buff.clear();
+
     return duration.count();
 }
 
 double loadTestSharedPtr(int N) {
-    std::vector<SharedPtr<int>> buff(N);
+    std::vector<SharedPtr<int>>& buff = scratchBuffer<SharedPtr<int>>(N);
 
+    perfRegionBegin();
     auto start = std::chrono::high_resolution_clock::now();
     for (int i = 0; i < N; ++i) {
         if (i % 5 == 0) {
-            buff[i] = SharedPtr<int>(new int(i));
+            buff[i] = makeShared<int>(i);
         } else {
             buff[i] = buff[i - (i % 5)];
         }
     }
     auto end = std::chrono::high_resolution_clock::now();
+    perfRegionEnd();
     std::chrono::duration<double> duration = end - start;
 
+    buff.clear();
+
     return duration.count();
 }
 
-// Для стандартных STL UniquePtr и SharedPtr
-double loadTestStdUniquePtr(int N) {
-    std::vector<std::unique_ptr<int>> buff(N);
+// Преобразования SharedPtr: N новых указателей на данные одного владельца.
+// Каждый результат читается, чтобы значение не выбрасывалось оптимизатором
+template <typename Result, typename Make>
+double loadTestConversion(int N, Make make) {
+    std::vector<Result>& buff = scratchBuffer<Result>(N);
+    double sink = 0;
 
+    perfRegionBegin();
     auto start = std::chrono::high_resolution_clock::now();
     for (int i = 0; i < N; ++i) {
-        if (i % 5 == 0) {
-            buff[i] = std::make_unique<int>(i);
+        buff[i] = make(i);
+        sink += *buff[i];
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    perfRegionEnd();
+    std::chrono::duration<double> duration = end - start;
+
+    buff.clear();
+    assert(sink > 0);
+    (void)sink;
+    return duration.count();
+}
+
+// SharedPtr<float> = SharedPtr<int>: новый объект на каждое преобразование
+double loadTestConvertCopy(int N) {
+    SharedPtr<int> source = makeShared<int>(42);
+    return loadTestConversion<SharedPtr<float>>(N, [&source](int) { return SharedPtr<float>(source); });
+}
+
+double loadTestConvertView(int N) {
+    SharedPtr<int> source = makeShared<int>(42);
+    return loadTestConversion<SharedValueView<float, int>>(N, [&source](int) { return viewAs<float>(source); });
+}
+
+double loadTestAliasing(int N) {
+    SharedPtr<AliasTarget> owner = makeShared<AliasTarget>(AliasTarget{1, 2.5f});
+    return loadTestConversion<SharedPtr<float>>(N, [&owner](int) {
+        return SharedPtr<float>(owner, &owner.get()->weight);
+    });
+}
+
+double loadTestStdAliasing(int N) {
+    std::shared_ptr<AliasTarget> owner = std::make_shared<AliasTarget>(AliasTarget{1, 2.5f});
+    return loadTestConversion<std::shared_ptr<float>>(N, [&owner](int) {
+        return std::shared_ptr<float>(owner, &owner->weight);
+    });
+}
+
+// Изменение N строк реестра: copies - сколько имен делят каждую строку (1 - строка у одного имени).
+// edit меняет последний символ строки, длина строки не меняется
+template <typename Ptr, typename Make, typename Edit>
+double loadTestStringEdits(int N, int copies, Make make, Edit edit) {
+    std::vector<Ptr> buff;
+    buff.reserve(N);
+    for (int i = 0; i < N; ++i) {
+        buff.push_back(i % copies == 0 ? make() : buff[i - i % copies]);
+    }
+
+    perfRegionBegin();
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < N; ++i) {
+        edit(buff[i]);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    perfRegionEnd();
+    std::chrono::duration<double> duration = end - start;
+
+    assert(buff[N - 1]->back() == '!');
+    return duration.count();
+}
+
+const char* const editedText = "value stored under a registry name";
+
+// Изменение вручную: каждая запись строит новую строку и новый SharedPtr
+double loadTestStringReplace(int N) {
+    using Ptr = SharedPtr<std::string>;
+    return loadTestStringEdits<Ptr>(N, 4, [] { return makeShared<std::string>(editedText, 32); },
+                                    [](Ptr& p) {
+                                        Ptr edited = makeShared<std::string>(*p);
+                                        edited.get()->back() = '!';
+                                        p = std::move(edited);
+                                    });
+}
+
+double loadTestCowWriteShared(int N) {
+    using Ptr = CowPtr<std::string>;
+    return loadTestStringEdits<Ptr>(N, 4, [] { return makeCow<std::string>(editedText, 32); },
+                                    [](Ptr& p) { p.write().back() = '!'; });
+}
+
+// Строки не разделяются: запись меняет их на месте
+double loadTestCowWriteUnique(int N) {
+    using Ptr = CowPtr<std::string>;
+    return loadTestStringEdits<Ptr>(N, 1, [] { return makeCow<std::string>(editedText, 32); },
+                                    [](Ptr& p) { p.write().back() = '!'; });
+}
+
+double loadTestCowCopy(int N) {
+    CowPtr<std::string> source = makeCow<std::string>(editedText);
+    std::vector<CowPtr<std::string>>& buff = scratchBuffer<CowPtr<std::string>>(N);
+    perfRegionBegin();
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < N; ++i) {
+        buff[i] = source;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    perfRegionEnd();
+    std::chrono::duration<double> duration = end - start;
+    assert(source.useCount() == N + 1);
+    buff.clear();
+    return duration.count();
+}
+
+double loadTestStringCopy(int N) {
+    const std::string source = editedText;
+    std::vector<std::string>& buff = scratchBuffer<std::string>(N);
+    perfRegionBegin();
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < N; ++i) {
+        buff[i] = source;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    perfRegionEnd();
+    std::chrono::duration<double> duration = end - start;
+    assert(buff[N - 1] == source);
+    buff.clear();
+    return duration.count();
+}
+
+// Задержка освобождения в вызывающем потоке. N списков LinkedListShared<int>: каждый
+// bigListEvery-й из bigListNodes узлов, остальные из smallListNodes. Построение не измеряется.
+// После освобождения поток ждет releasePause, как сервер - следующего запроса.
+// Задержка каждого освобождения уходит в recordLatency, возвращается их сумма
+const int bigListEvery = 50;
+const int bigListNodes = 50'000;
+const int smallListNodes = 16;
+const std::chrono::microseconds releasePause(50);
+const std::size_t listNodeBytes = 64; // Оценка узла со счетчиком ссылок и заголовком malloc
+
+template <typename Release>
+double loadTestReleaseLatency(int N, Release release) {
+    double total = 0;
+    for (int i = 0; i < N; ++i) {
+        const int nodes = i % bigListEvery == 0 ? bigListNodes : smallListNodes;
+        SmartPointer::LinkedListShared<int> list;
+        for (int j = 0; j < nodes; ++j) {
+            list.pushFront(j);
+        }
+        auto start = std::chrono::high_resolution_clock::now();
+        release(list, nodes);
+        auto end = std::chrono::high_resolution_clock::now();
+        const double seconds = std::chrono::duration<double>(end - start).count();
+        recordLatency(seconds);
+        total += seconds;
+        std::this_thread::sleep_for(releasePause);
+    }
+    return total;
+}
+
+double loadTestReleaseInline(int N) {
+    return loadTestReleaseLatency(N, [](SmartPointer::LinkedListShared<int>& list, int) { list.clear(); });
+}
+
+// pendingMiB - ограничение очереди фонового потока в мегабайтах
+double loadTestReleaseDeferred(int N, int pendingMiB) {
+    BackgroundReclaimer reclaimer(static_cast<std::size_t>(pendingMiB) << 20);
+    const double seconds = loadTestReleaseLatency(N, [&reclaimer](SmartPointer::LinkedListShared<int>& list, int nodes) {
+        reclaimer.retireOwner(std::move(list), nodes * listNodeBytes);
+    });
+    reclaimer.flush();
+    return seconds;
+}
+
+// Для стандартных STL UniquePtr и SharedPtr
+double loadTestStdUniquePtr(int N) {
+    std::vector<std::unique_ptr<int>>& buff = scratchBuffer<std::unique_ptr<int>>(N);
+
+    perfRegionBegin();
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < N; ++i) {
+        if (i % 5 == 0) {
+            buff[i] = std::make_unique<int>(i);
         } else {
             buff[i] = std::move(buff[i - (i % 5)]);
         }
     }
     auto end = std::chrono::high_resolution_clock::now();
+    perfRegionEnd();
     std::chrono::duration<double> duration = end - start;
 
+    buff.clear();
+
     return duration.count();
 }
 
 double loadTestStdSharedPtr(int N) {
-    std::vector<std::shared_ptr<int>> buff(N);
+    std::vector<std::shared_ptr<int>>& buff = scratchBuffer<std::shared_ptr<int>>(N);
 
+    perfRegionBegin();
     auto start = std::chrono::high_resolution_clock::now();
     for (int i = 0; i < N; ++i) {
         if (i % 5 == 0) {
@@ -211,66 +1654,726 @@ double loadTestStdSharedPtr(int N) {
         }
     }
     auto end = std::chrono::high_resolution_clock::now();
+    perfRegionEnd();
     std::chrono::duration<double> duration = end - start;
 
+    buff.clear();
+
     return duration.count();
 }
 
-void runLoadTestsAndPlot() {
-    const int step = 500'000;
-    const int maxElements = 20 * step;
+template <typename T, typename RefCount>
+int useCountOf(const SharedPtr<T, RefCount>& ptr) {
+    return ptr.useCount();
+}
 
-    // Открываем файл для записи результатов
-    std::ofstream file("load_test_results.csv");
-    if (!file.is_open()) {
-        std::cerr << "Ошибка при открытии файла для записи!\n";
-        return;
+template <typename T>
+int useCountOf(const std::shared_ptr<T>& ptr) {
+    return static_cast<int>(ptr.use_count());
+}
+
+// Многопоточный тест: каждый поток копирует общие указатели в свой буфер и сбрасывает старые копии
+template <typename Ptr, typename Make>
+double loadTestSharedCopiesMT(int N, int threads, Make make) {
+    const int sources = 64; // Немного общих объектов, чтобы потоки конкурировали за счетчики
+    const int slots = 250; // Не кратно sources, иначе каждое присваивание попадает в тот же блок
+    std::vector<Ptr> shared;
+    for (int i = 0; i < sources; ++i) {
+        shared.push_back(make(i));
+    }
+
+    std::vector<std::thread> workers;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&shared, N, threads, t]() {
+            std::vector<Ptr> local(slots);
+            for (int i = t; i < N; i += threads) {
+                local[i % slots] = shared[i % sources];
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end - start;
+
+    for (const auto& ptr : shared) {
+        assert(useCountOf(ptr) == 1); // Все копии из потоков сброшены
+    }
+    return duration.count();
+}
+
+double loadTestSharedPtrMT(int N, int threads) {
+    return loadTestSharedCopiesMT<ConcurrentSharedPtr<int>>(N, threads, [](int i) {
+        return makeShared<int, AtomicRefCount>(i);
+    });
+}
+
+double loadTestStdSharedPtrMT(int N, int threads) {
+    return loadTestSharedCopiesMT<std::shared_ptr<int>>(N, threads, [](int i) {
+        return std::make_shared<int>(i);
+    });
+}
+
+// Заполнение и опустошение списка дважды: второй проход показывает переиспользование узлов
+template <typename List>
+double loadTestListChurn(int N, List& list) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int round = 0; round < 2; ++round) {
+        for (int i = 0; i < N; ++i) {
+            list.pushFront(i);
+        }
+        for (int i = 0; i < N; ++i) {
+            list.popFront();
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end - start;
+
+    return duration.count();
+}
+
+double loadTestListUnique(int N) {
+    SmartPointer::LinkedListUnique<int> list;
+    return loadTestListChurn(N, list);
+}
+
+double loadTestListUniquePool(int N) {
+    PoolResource pool;
+    SmartPointer::LinkedListUnique<int, PoolAllocator<int>> list{PoolAllocator<int>(pool)};
+    return loadTestListChurn(N, list);
+}
+
+double loadTestListShared(int N) {
+    SmartPointer::LinkedListShared<int> list;
+    return loadTestListChurn(N, list);
+}
+
+double loadTestListSharedPool(int N) {
+    PoolResource pool;
+    SmartPointer::LinkedListShared<int, PoolAllocator<int>> list{PoolAllocator<int>(pool)};
+    return loadTestListChurn(N, list);
+}
+
+// Объект для IntrusivePtr: то же число, что и в тестах SharedPtr<int>, но со своим счетчиком
+template <typename RefCount>
+struct IntrusiveInt : RefCounted<RefCount> {
+    explicit IntrusiveInt(int value) : value(value) {}
+    int value;
+};
+
+template <typename RefCount>
+double loadTestIntrusive(int N) {
+    using Ptr = IntrusivePtr<IntrusiveInt<RefCount>>;
+    std::vector<Ptr>& buff = scratchBuffer<Ptr>(N);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < N; ++i) {
+        if (i % 5 == 0) {
+            buff[i] = makeIntrusive<IntrusiveInt<RefCount>>(i);
+        } else {
+            buff[i] = buff[i - (i % 5)];
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end - start;
+
+    buff.clear();
+    return duration.count();
+}
+
+double loadTestIntrusivePtr(int N) {
+    return loadTestIntrusive<NonAtomicRefCount>(N);
+}
+
+double loadTestIntrusivePtrAtomic(int N) {
+    return loadTestIntrusive<AtomicRefCount>(N);
+}
+
+// Поиск отсутствующего значения - полный обход списка; список строится вне замера
+template <typename List>
+double loadTestListFind(int N) {
+    const int searches = 5;
+    List list;
+    for (int i = 0; i < N; ++i) {
+        list.pushFront(i);
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < searches; ++i) {
+        bool found = list.find(-1);
+        assert(!found);
+        (void)found;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end - start;
+
+    return duration.count() / searches;
+}
+
+double loadTestFindUnique(int N) {
+    return loadTestListFind<SmartPointer::LinkedListUnique<int>>(N);
+}
+
+double loadTestFindShared(int N) {
+    return loadTestListFind<SmartPointer::LinkedListShared<int>>(N);
+}
+
+double loadTestFindUnrolled(int N) {
+    return loadTestListFind<SmartPointer::LinkedListUnrolled<int>>(N);
+}
+
+// Список в блоке OffsetHeap: каждый переход по узлу прибавляет смещение к адресу
+double loadTestFindOffset(int N) {
+    MappedSegment segment = MappedSegment::inMemory(static_cast<std::size_t>(N) * 16 + 4096);
+    auto* list = segment.heap().construct<SmartPointer::LinkedListOffset<int>>(segment.heap());
+    for (int i = 0; i < N; ++i) {
+        list->pushFront(i);
+    }
+
+    const int searches = 5;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < searches; ++i) {
+        bool found = list->find(-1);
+        assert(!found);
+        (void)found;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end - start;
+
+    segment.heap().destroy(list);
+    return duration.count() / searches;
+}
+
+// Одинаковые псевдослучайные значения для всех вариантов сортировки
+std::vector<int> sortInput(int N) {
+    std::mt19937 generator(12345);
+    std::vector<int> values(N);
+    for (auto& value : values) {
+        value = static_cast<int>(generator());
+    }
+    return values;
+}
+
+// Сортировка списка; список строится вне замера
+template <typename List, typename Sort>
+double loadTestSort(int N, Sort sort) {
+    const std::vector<int> values = sortInput(N);
+    List list;
+    for (int value : values) {
+        list.push_front(value);
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    sort(list);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end - start;
+
+    assert(std::is_sorted(list.begin(), list.end()));
+    return duration.count();
+}
+
+// LinkedListUnique с интерфейсом push_front для loadTestSort
+struct SortableList : SmartPointer::LinkedListUnique<int> {
+    void push_front(int value) {
+        pushFront(value);
+    }
+};
+
+double loadTestListSort(int N, int threads) {
+    return loadTestSort<SortableList>(N, [threads](SortableList& list) { list.parallelSort(threads); });
+}
+
+// Значения копируются в вектор, сортируются и список собирается заново
+double loadTestListCopySort(int N) {
+    return loadTestSort<SortableList>(N, [](SortableList& list) {
+        std::vector<int> values(list.begin(), list.end());
+        std::sort(values.begin(), values.end());
+        list.clear();
+        for (auto it = values.rbegin(); it != values.rend(); ++it) {
+            list.pushFront(*it);
+        }
+    });
+}
+
+double loadTestForwardListSort(int N) {
+    return loadTestSort<std::forward_list<int>>(N, [](std::forward_list<int>& list) { list.sort(); });
+}
+
+// Сборка контейнера из N значений; значения готовятся и контейнер удаляется вне замера
+template <typename Build>
+double loadTestBuild(int N, Build build) {
+    std::vector<int> values(N);
+    std::iota(values.begin(), values.end(), 0);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    auto container = build(values);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end - start;
+
+    assert(*container.begin() == 0);
+    return duration.count();
+}
+
+double loadTestBuildVector(int N) {
+    return loadTestBuild(N, [](const std::vector<int>& values) {
+        return std::vector<int>(values.begin(), values.end());
+    });
+}
+
+double loadTestBuildUniquePushFront(int N) {
+    return loadTestBuild(N, [](const std::vector<int>& values) {
+        SmartPointer::LinkedListUnique<int> list;
+        for (auto it = values.rbegin(); it != values.rend(); ++it) {
+            list.pushFront(*it);
+        }
+        return list;
+    });
+}
+
+double loadTestBuildUniqueAssign(int N, int threads) {
+    return loadTestBuild(N, [threads](const std::vector<int>& values) {
+        SmartPointer::LinkedListUnique<int> list;
+        list.parallelAssign(threads, values.begin(), values.end());
+        return list;
+    });
+}
+
+// Пул и арена берут память под узлы кусками; строится в одном потоке
+double loadTestBuildUniqueAssignPool(int N) {
+    PoolResource pool;
+    return loadTestBuild(N, [&pool](const std::vector<int>& values) {
+        SmartPointer::LinkedListUnique<int, PoolAllocator<int>> list{PoolAllocator<int>(pool)};
+        list.assign(values.begin(), values.end());
+        return list;
+    });
+}
+
+double loadTestBuildUniqueAssignArena(int N) {
+    ArenaResource arena;
+    return loadTestBuild(N, [&arena](const std::vector<int>& values) {
+        SmartPointer::LinkedListUnique<int, ArenaAllocator<int>> list{ArenaAllocator<int>(arena)};
+        list.assign(values.begin(), values.end());
+        return list;
+    });
+}
+
+// Страницы файла выгружаются из кэша ОС, чтобы загрузка читала диск, как после перезапуска машины.
+// Без posix_fadvise файл остается в кэше, и замер показывает только теплый старт
+void dropFileCache(const std::string& path) {
+#ifdef __linux__
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        fdatasync(fd); // Грязные страницы выгрузить нельзя
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+#else
+    (void)path;
+#endif
+}
+
+const char* const listSnapshotPath = "__bench_list.snap";
+
+// Снимок N значений на диске; возвращает их сумму для проверки загрузки
+long long prepareListSnapshot(int N) {
+    std::vector<int> values(N);
+    std::iota(values.begin(), values.end(), 0);
+    Snapshot::save(listSnapshotPath, values);
+    dropFileCache(listSnapshotPath);
+    return std::accumulate(values.begin(), values.end(), 0LL);
+}
+
+// Перезапуск без снимков: значения читаются потоком и вставляются по одному
+double loadTestListRebuild(int N) {
+    const long long expected = prepareListSnapshot(N);
+    auto start = std::chrono::high_resolution_clock::now();
+    std::ifstream file(listSnapshotPath, std::ios::binary);
+    file.seekg(Snapshot::dataOffset);
+    SmartPointer::LinkedListUnique<int> list;
+    int value = 0;
+    for (int i = 0; i < N && file.read(reinterpret_cast<char*>(&value), sizeof(value)); ++i) {
+        list.pushFront(value);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end - start;
+
+    assert(std::accumulate(list.begin(), list.end(), 0LL) == expected);
+    (void)expected;
+    std::remove(listSnapshotPath);
+    return duration.count();
+}
+
+template <typename List>
+double loadTestListSnapshot(int N, List& list) {
+    const long long expected = prepareListSnapshot(N);
+    auto start = std::chrono::high_resolution_clock::now();
+    Snapshot::load(listSnapshotPath, list);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end - start;
+
+    assert(std::accumulate(list.begin(), list.end(), 0LL) == expected);
+    (void)expected;
+    std::remove(listSnapshotPath);
+    return duration.count();
+}
+
+double loadTestListSnapshotLoad(int N) {
+    SmartPointer::LinkedListUnique<int> list;
+    return loadTestListSnapshot(N, list);
+}
+
+double loadTestListSnapshotArena(int N) {
+    ArenaResource arena;
+    SmartPointer::LinkedListUnique<int, ArenaAllocator<int>> list{ArenaAllocator<int>(arena)};
+    return loadTestListSnapshot(N, list);
+}
+
+// Значения читаются прямо из отображенных страниц, узлы не создаются
+double loadTestListSnapshotView(int N) {
+    const long long expected = prepareListSnapshot(N);
+    auto start = std::chrono::high_resolution_clock::now();
+    Snapshot::View<int> view(listSnapshotPath);
+    const long long sum = std::accumulate(view.begin(), view.end(), 0LL);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end - start;
+
+    assert(sum == expected);
+    (void)sum;
+    (void)expected;
+    std::remove(listSnapshotPath);
+    return duration.count();
+}
+
+const char* const registryTracePath = "__bench_registry.txt";
+const char* const registrySnapshotPath = "__bench_registry.snap";
+
+// Сценарий из N имен: числа, строки и копии SharedPtr вперемешку
+void writeRegistryTrace(int N) {
+    std::ofstream trace(registryTracePath, std::ios::binary | std::ios::trunc);
+    for (int i = 0; i < N; ++i) {
+        switch (i % 4) {
+            case 0: trace << "create unique int u" << i << " " << i << "\n"; break;
+            case 1: trace << "create shared int s" << i << " " << i << "\n"; break;
+            case 2: trace << "copy shared int c" << i << " s" << i - 1 << "\n"; break;
+            default: trace << "create unique string t" << i << " value " << i << "\n"; break;
+        }
     }
+}
+
+// Перезапуск без снимков: реестр восстанавливается повтором сценария команд
+double loadTestRegistryRebuild(int N) {
+    clearRegistry();
+    writeRegistryTrace(N);
+    dropFileCache(registryTracePath);
 
-    // Заголовок CSV
-    file << "Elements,UniquePtr,StdUniquePtr,SharedPtr,StdSharedPtr\n";
-
-    std::cout << std::setw(20) << "Elements"
-            << std::setw(20) << "UniquePtr (s)"
-            << std::setw(20) << "std::unique_ptr (s)"
-            << std::setw(20) << "SharedPtr (s)"
-            << std::setw(20) << "std::shared_ptr (s)"
-            << std::setw(25) << "UniquePtr Speed (%)"
-            << std::setw(25) << "SharedPtr Speed (%)" << std::endl;
-
-    // Запускаем тесты и записываем результаты в файл
-    for (int items = step; items <= maxElements; items += step) {
-        double timeUnique = loadTestUniquePtr(items);
-        double timeStdUnique = loadTestStdUniquePtr(items);
-        double timeShared = loadTestSharedPtr(items);
-        double timeStdShared = loadTestStdSharedPtr(items);
-
-        file << items << ","
-             << std::fixed << std::setprecision(7) << timeUnique << ","
-             << timeStdUnique << ","
-             << timeShared << ","
-             << timeStdShared << "\n";
-
-        double uniqueSpeed = (timeStdUnique / timeUnique - 1) * 100;
-        double sharedSpeed = (timeStdShared / timeShared - 1) * 100;
-
-        // Выводим на экран
-        std::cout << std::setw(20) << items
-                << std::setw(20) << timeUnique
-                << std::setw(20) << timeStdUnique
-                << std::setw(20) << timeShared
-                << std::setw(20) << timeStdShared 
-                << std::setw(25) << uniqueSpeed
-                << std::setw(25) << sharedSpeed << std::endl;
-    }
-    file.close();
-    std::cout << "Нагрузочное тестирование окончено, результаты сохранены в 'load_test_results.csv'\n";
-
-    // Запускаем gnuplot
-    int result = system("gnuplot plot.gp");
-    if (result != 0) {
-        std::cerr << "Ошибка при запуске gnuplot, убедитесь, что он установлен и доступен в PATH\n";
-    } else {
-        std::cout << "График построен и сохранен в 'load_test_plot.png'\n";
+    auto start = std::chrono::high_resolution_clock::now();
+    std::ifstream trace(registryTracePath, std::ios::binary);
+    std::ofstream nullStream;
+    const BatchStats stats = runBatch(trace, nullStream);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end - start;
+
+    assert(stats.errors == 0 && stats.operations == N);
+    (void)stats;
+    clearRegistry();
+    std::remove(registryTracePath);
+    return duration.count();
+}
+
+double loadTestRegistrySnapshotLoad(int N) {
+    clearRegistry();
+    writeRegistryTrace(N);
+    std::ifstream trace(registryTracePath, std::ios::binary);
+    std::ofstream nullStream;
+    runBatch(trace, nullStream);
+    saveRegistry(registrySnapshotPath);
+    clearRegistry();
+    dropFileCache(registrySnapshotPath);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    const std::size_t loaded = loadRegistry(registrySnapshotPath);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end - start;
+
+    assert(loaded == static_cast<std::size_t>(N));
+    (void)loaded;
+    clearRegistry();
+    std::remove(registryTracePath);
+    std::remove(registrySnapshotPath);
+    return duration.count();
+}
+
+double loadTestBuildSharedPushFront(int N) {
+    return loadTestBuild(N, [](const std::vector<int>& values) {
+        SmartPointer::LinkedListShared<int> list;
+        for (auto it = values.rbegin(); it != values.rend(); ++it) {
+            list.pushFront(*it);
+        }
+        return list;
+    });
+}
+
+double loadTestBuildSharedAssign(int N, int threads) {
+    return loadTestBuild(N, [threads](const std::vector<int>& values) {
+        SmartPointer::LinkedListShared<int> list;
+        list.parallelAssign(threads, values.begin(), values.end());
+        return list;
+    });
+}
+
+// Проход по непрерывному массиву: scan(data, n, value) ищет или считает отсутствующее значение
+template <typename T, typename Scan>
+double loadTestScan(int N, Scan scan) {
+    const int passes = 10;
+    AlignedArray<T> data = makeUniqueArrayForOverwrite<T>(N); // Заполняется ниже целиком
+    for (int i = 0; i < N; ++i) {
+        data[i] = static_cast<T>(i % 100);
     }
+
+    std::size_t sink = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < passes; ++i) {
+        sink += scan(data.get(), data.size(), static_cast<T>(101));
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end - start;
+
+    assert(sink == static_cast<std::size_t>(N) * passes || sink == 0);
+    (void)sink;
+    return duration.count() / passes;
+}
+
+double loadTestFindScalarInt(int N) {
+    return loadTestScan<int>(N, SimdSearch::scalarFind<int>);
+}
+
+double loadTestFindSimdInt(int N) {
+    return loadTestScan<int>(N, SimdSearch::find<int>);
+}
+
+double loadTestCountScalarInt(int N) {
+    return loadTestScan<int>(N, SimdSearch::scalarCount<int>);
+}
+
+double loadTestCountSimdInt(int N) {
+    return loadTestScan<int>(N, SimdSearch::count<int>);
+}
+
+double loadTestFindScalarFloat(int N) {
+    return loadTestScan<float>(N, SimdSearch::scalarFind<float>);
+}
+
+double loadTestFindSimdFloat(int N) {
+    return loadTestScan<float>(N, SimdSearch::find<float>);
+}
+
+double loadTestCountUnrolled(int N) {
+    SmartPointer::LinkedListUnrolled<int> list;
+    for (int i = 0; i < N; ++i) {
+        list.pushFront(i % 100);
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::size_t found = list.count(101);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end - start;
+
+    assert(found == 0);
+    (void)found;
+    return duration.count();
+}
+
+// Поиск N существующих имен в разброс: на больших таблицах каждое имя - отдельный промах кэша
+template <typename Table, typename Insert, typename Contains>
+double loadTestNameLookup(int N, Insert insert, Contains contains) {
+    std::vector<std::string> names(N);
+    Table table;
+    for (int i = 0; i < N; ++i) {
+        names[i] = "pointer" + std::to_string(i);
+        insert(table, names[i], i);
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    long found = 0;
+    for (int i = 0; i < N; ++i) {
+        const std::string& name = names[(static_cast<std::size_t>(i) * 2654435761u) % N];
+        found += contains(table, std::string_view(name));
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end - start;
+
+    assert(found == N);
+    (void)found;
+    return duration.count();
+}
+
+double loadTestNameTableLookup(int N) {
+    return loadTestNameLookup<NameTable<int>>(N,
+        [](NameTable<int>& table, const std::string& name, int value) { *table.tryEmplace(name).first = value; },
+        [](const NameTable<int>& table, std::string_view name) { return table.find(name) != nullptr; });
+}
+
+double loadTestUnorderedMapLookup(int N) {
+    using Map = std::unordered_map<std::string, int>;
+    return loadTestNameLookup<Map>(N,
+        [](Map& map, const std::string& name, int value) { map[name] = value; },
+        // До C++20 искать в unordered_map можно только по std::string
+        [](const Map& map, std::string_view name) { return map.find(std::string(name)) != map.end(); });
+}
+
+// Полный путь реестра через пакетный режим: N имен длиной 32 символа (длиннее буфера
+// короткой строки) создаются, затем в разброс находятся (append дописывает символ на месте)
+// и удаляются. Время - только выполнение команд, без чтения сценария
+double loadTestRegistryOps(int N) {
+    clearRegistry();
+    std::ofstream nullStream;
+    double seconds = 0.0;
+    const char* const commands[] = {"create shared string ", "append ", "delete shared "};
+    for (int phase = 0; phase < 3; ++phase) {
+        {
+            std::ofstream trace(registryTracePath, std::ios::binary | std::ios::trunc);
+            char name[40];
+            for (int i = 0; i < N; ++i) {
+                // Множитель - простое число, поэтому при phase > 0 каждое имя встречается ровно один раз
+                const int k = phase == 0 ? i : static_cast<int>((static_cast<std::size_t>(i) * 2654435761u) % N);
+                std::snprintf(name, sizeof(name), "registry/session/%08d/handle", k);
+                trace << commands[phase] << name << (phase == 2 ? "\n" : " x\n");
+            }
+        }
+        std::ifstream trace(registryTracePath, std::ios::binary);
+        const BatchStats stats = runBatch(trace, nullStream);
+        assert(stats.errors == 0 && stats.operations == N);
+        (void)stats;
+        seconds += stats.seconds;
+    }
+    std::remove(registryTracePath);
+    return seconds;
+}
+
+// Потоки попеременно кладут значение в общий стек и снимают его: N пар операций на всех
+template <typename Stack>
+double loadTestStackMT(int N, int threads) {
+    Stack stack;
+    std::vector<std::thread> workers;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&stack, N, threads, t]() {
+            int value = 0;
+            for (int i = t; i < N; i += threads) {
+                stack.pushFront(i);
+                stack.popFront(value);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end - start;
+
+    return duration.count();
+}
+
+// Односвязный список под мьютексом: точка отсчета для LockFreeStack
+class MutexStack {
+private:
+    std::mutex mutex;
+    std::forward_list<int> list;
+
+public:
+    void pushFront(int value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        list.push_front(value);
+    }
+
+    bool popFront(int& value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (list.empty()) {
+            return false;
+        }
+        value = list.front();
+        list.pop_front();
+        return true;
+    }
+};
+
+double loadTestLockFreeStackMT(int N, int threads) {
+    return loadTestStackMT<SmartPointer::LockFreeStack<int>>(N, threads);
+}
+
+double loadTestMutexStackMT(int N, int threads) {
+    return loadTestStackMT<MutexStack>(N, threads);
+}
+
+// Читатели обходят список из 1000 элементов, пока один писатель снимает и добавляет узлы.
+// Время - пока читатели не сделают N обходов на всех
+template <typename List, typename Read, typename Write>
+double loadTestListReaders(int N, int readers, List& list, Read read, Write write) {
+    for (int i = 0; i < 1000; ++i) {
+        list.pushFront(i);
+    }
+
+    std::atomic<bool> done{false};
+    std::thread writer([&list, &done, write]() {
+        for (int i = 0; !done.load(std::memory_order_relaxed); ++i) {
+            write(list, i % 1000);
+        }
+    });
+
+    std::vector<std::thread> workers;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < readers; ++r) {
+        workers.emplace_back([&list, N, readers, r, read]() {
+            int found = 0; // Результат нужен, иначе обход без побочных эффектов можно выбросить
+            for (int i = r; i < N; i += readers) {
+                found += read(list, -1);
+            }
+            assert(found == 0);
+            (void)found;
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    done = true;
+    writer.join();
+    std::chrono::duration<double> duration = end - start;
+
+    return duration.count();
+}
+
+double loadTestListReadersEpoch(int N, int readers) {
+    using List = SmartPointer::LinkedListUnique<int, std::allocator<int>, SmartPointer::EpochReclaim>;
+    List list;
+    return loadTestListReaders(N, readers, list,
+        [](List& l, int value) { return l.find(value); },
+        [](List& l, int value) { l.popFront(); l.pushFront(value); });
+}
+
+// Тот же список без отложенного освобождения: каждый обход под разделяемой блокировкой
+struct LockedList {
+    std::shared_mutex mutex;
+    SmartPointer::LinkedListUnique<int> list;
+
+    void pushFront(int value) {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        list.pushFront(value);
+    }
+};
+
+double loadTestListReadersLocked(int N, int readers) {
+    LockedList locked;
+    return loadTestListReaders(N, readers, locked,
+        [](LockedList& l, int value) {
+            std::shared_lock<std::shared_mutex> lock(l.mutex);
+            return l.list.find(value);
+        },
+        [](LockedList& l, int value) {
+            std::unique_lock<std::shared_mutex> lock(l.mutex);
+            l.list.popFront();
+            l.list.pushFront(value);
+        });
 }
@@ -4,4 +4,75 @@
 void functionalTest();
 void runLoadTestsAndPlot();
 
+// Нагрузочные тесты: N операций, результат - время в секундах
+double loadTestUniquePtr(int N);
+double loadTestSharedPtr(int N);
+double loadTestStdUniquePtr(int N);
+double loadTestStdSharedPtr(int N);
+
+double loadTestConvertCopy(int N);
+double loadTestConvertView(int N);
+double loadTestAliasing(int N);
+double loadTestStdAliasing(int N);
+
+double loadTestStringReplace(int N);
+double loadTestCowWriteShared(int N);
+double loadTestCowWriteUnique(int N);
+double loadTestCowCopy(int N);
+double loadTestStringCopy(int N);
+
+double loadTestReleaseInline(int N);
+double loadTestReleaseDeferred(int N, int pendingMiB);
+
+double loadTestSharedPtrMT(int N, int threads);
+double loadTestStdSharedPtrMT(int N, int threads);
+double loadTestLockFreeStackMT(int N, int threads);
+double loadTestMutexStackMT(int N, int threads);
+double loadTestListReadersEpoch(int N, int readers);
+double loadTestListReadersLocked(int N, int readers);
+
+double loadTestListUnique(int N);
+double loadTestListUniquePool(int N);
+double loadTestListShared(int N);
+double loadTestListSharedPool(int N);
+
+double loadTestIntrusivePtr(int N);
+double loadTestIntrusivePtrAtomic(int N);
+
+double loadTestFindUnique(int N);
+double loadTestFindShared(int N);
+double loadTestFindUnrolled(int N);
+double loadTestFindOffset(int N);
+
+double loadTestListSort(int N, int threads);
+double loadTestListCopySort(int N);
+double loadTestForwardListSort(int N);
+
+double loadTestBuildVector(int N);
+double loadTestBuildUniquePushFront(int N);
+double loadTestBuildUniqueAssign(int N, int threads);
+double loadTestBuildUniqueAssignPool(int N);
+double loadTestBuildUniqueAssignArena(int N);
+double loadTestBuildSharedPushFront(int N);
+double loadTestBuildSharedAssign(int N, int threads);
+
+double loadTestListRebuild(int N);
+double loadTestListSnapshotLoad(int N);
+double loadTestListSnapshotArena(int N);
+double loadTestListSnapshotView(int N);
+double loadTestRegistryRebuild(int N);
+double loadTestRegistrySnapshotLoad(int N);
+
+double loadTestFindScalarInt(int N);
+double loadTestFindSimdInt(int N);
+double loadTestCountScalarInt(int N);
+double loadTestCountSimdInt(int N);
+double loadTestFindScalarFloat(int N);
+double loadTestFindSimdFloat(int N);
+double loadTestCountUnrolled(int N);
+
+double loadTestNameTableLookup(int N);
+double loadTestUnorderedMapLookup(int N);
+double loadTestRegistryOps(int N);
+
 #endif 